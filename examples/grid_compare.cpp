@@ -1,7 +1,7 @@
 /**
  * @file
  * @brief Grid compare
- * Usage: grid_compare file1 file2 threshold [showAll]
+ * Usage: grid_compare file1 file2 threshold [showAll|any] [--hashes]
  * @author Erwin Meza Vega <emezav@unicauca.edu.co> <emezav@gmail.com>
  * @copyright MIT License
  */
@@ -18,6 +18,7 @@ using std::map;
 using std::string;
 using std::vector;
 
+using geo::CompareMode;
 using geo::Grid;
 using geo::Options;
 using geo::GridFormat;
@@ -41,30 +42,83 @@ void usage(char *program);
  */
 void compare(const Grid & gridA, const Grid & gridB, float threshold, bool showAll = false);
 
+/**
+ * @brief Compares two grid files with hash sidecars, only the blocks with different hashes are read
+ * @param pathA first grid
+ * @param pathB second grid
+ * @param threshold Theshold that defines if two values are considered equal
+ * @param showAll Show all differences
+ */
+void compareHashed(const string &pathA, const string &pathB, float threshold, bool showAll = false);
+
 int main(int argc, char *argv[])
 {
 
+  // Build hash sidecars, the other arguments are positional
+  bool buildHashes = false;
+  vector<string> args;
+
+  for (int i = 0; i < argc; i++)
+  {
+    string arg(argv[i]);
+    if (arg == "--hashes") {
+      buildHashes = true;
+    } else {
+      args.push_back(arg);
+    }
+  }
+
+  argc = static_cast<int>(args.size());
+
   if (argc < 3)
   {
     usage(argv[0]);
   }
 
-  string pathA(argv[1]);
-  string pathB(argv[2]);
+  string pathA(args[1]);
+  string pathB(args[2]);
 
   bool showAll = false;
 
   float threshold{EPS};
   // Check if threshold was provided
   if (argc >= 4) {
-    threshold = std::strtof(argv[3], nullptr);
+    threshold = std::strtof(args[3].c_str(), nullptr);
   }
 
   // Check if showAll was provided after rpe
-  if (argc >= 5 && string(argv[4]).compare("true") == 0) {
+  if (argc >= 5 && args[4].compare("true") == 0) {
     showAll = true;
   }
 
+  // Only check if there are differences, exit status 1 if there are
+  bool any = (argc >= 5 && args[4].compare("any") == 0);
+
+  if (buildHashes) {
+    for (const string &path : {pathA, pathB}) {
+      geo::GridHashes hashes;
+      if (geo::LoadHashes(path, hashes) != geoStatus::SUCCESS && geo::BuildHashes(path) != geoStatus::SUCCESS) {
+        cerr << "Unable to build the hashes of " << path << endl;
+      }
+    }
+  }
+
+  // Equal hash sidecars, the grids are not read
+  if (threshold > 0.0f && geo::IdenticalGrids(pathA, pathB)) {
+    if (any) {
+      cout << "Grids are equal." << endl;
+    }
+    exit(EXIT_SUCCESS);
+  }
+
+  // Only the blocks with different hashes are read
+  geo::GridHashes hashesA, hashesB;
+  if (!any && threshold > 0.0f && geo::LoadHashes(pathA, hashesA) == geoStatus::SUCCESS &&
+      geo::LoadHashes(pathB, hashesB) == geoStatus::SUCCESS && hashesA.comparable(hashesB)) {
+    compareHashed(pathA, pathB, threshold, showAll);
+    exit(EXIT_SUCCESS);
+  }
+
   Grid gridA, gridB;
 
   // Load first grid
@@ -83,6 +137,12 @@ int main(int argc, char *argv[])
     exit(EXIT_FAILURE);
   }
 
+  if (any) {
+    bool different = gridA.differs(gridB, CompareMode::ABSOLUTE, threshold);
+    cout << (different ? "Grids are different." : "Grids are equal.") << endl;
+    exit(different ? EXIT_FAILURE : EXIT_SUCCESS);
+  }
+
   compare(gridA, gridB, threshold, showAll);
 
   exit(EXIT_SUCCESS);
@@ -93,10 +153,13 @@ void usage(char *program)
 {
   cerr
       << "Usage: "
-      << program << " gridA gridB threshold [showAll]" << endl
+      << program << " gridA gridB threshold [showAll|any] [--hashes]" << endl
       << " Compares two grids and prints differences: row,column,valueA,valueB" << endl
       << " threshold is the maximum allowed difference between two values." << endl
       << " set showAll to true to show all diffs." << endl
+      << " set showAll to any to stop on the first difference: exit status is 1 if the grids differ." << endl
+      << " --hashes builds the missing hash sidecars (GRID.hash) of both grids. With up to date sidecars," << endl
+      << " blocks with equal hashes are not read, and grids with equal hashes are not read at all." << endl
       << " Grid format will be deduced from the file extension.";
 
     exit(EXIT_SUCCESS);
@@ -111,16 +174,15 @@ void compare(const Grid & gridA, const Grid & gridB, float threshold, bool showA
 
   auto [rows, columns] = gridA.dimensions();
 
-  int count = 0;
-  for (int i = 0; i < rows; i++) {
-    for (int j = 0; j < columns; j++) {
-      if (!gridA.same(gridB, i, j, threshold)) {
-        if (count++ < 100 || showAll) {
-        // Show difference
-        cout << i << "," << j <<": "<<gridA(i,j) << " <-> " << gridB(i,j) << endl;
-        }
-      }
-    }
+  // Whole grid comparison, only the listed cells are read again
+  size_t count = gridA.countDifferences(gridB, CompareMode::ABSOLUTE, threshold);
+  vector<size_t> differences = gridA.differences(gridB, CompareMode::ABSOLUTE, threshold, showAll ? count : 100);
+
+  for (size_t index : differences) {
+    int i = static_cast<int>(index / columns);
+    int j = static_cast<int>(index % columns);
+    // Show difference
+    cout << i << "," << j <<": "<<gridA(i,j) << " <-> " << gridB(i,j) << endl;
   }
 
   if (count > 100 && !showAll) {
@@ -131,4 +193,30 @@ void compare(const Grid & gridA, const Grid & gridB, float threshold, bool showA
     cout << count <<" total positions are different." << endl;
   }
 
-}
\ No newline at end of file
+}
+
+void compareHashed(const string &pathA, const string &pathB, float threshold, bool showAll) {
+
+  geo::GridDiff result;
+  vector<geo::DiffCell> differences;
+
+  if (geo::DiffGrids(pathA, pathB, CompareMode::ABSOLUTE, threshold, result, &differences,
+                     showAll ? std::numeric_limits<size_t>::max() : 100, 0) != geoStatus::SUCCESS) {
+    cerr << "Unable to read the grids" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  for (const geo::DiffCell &cell : differences) {
+    // Show difference
+    cout << cell.row << "," << cell.column <<": "<< cell.a << " <-> " << cell.b << endl;
+  }
+
+  if (result.different > 100 && !showAll) {
+    cout << "..." << endl;
+  }
+
+  if (result.different) {
+    cout << result.different <<" total positions are different." << endl;
+  }
+
+}
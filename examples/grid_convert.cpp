@@ -2,10 +2,15 @@
  * @file
  * @brief Grid conversion
  * Usage: grid_convert -if=INPUT_FORMAT -of=OUTPUT_FORMAT -input=IPUT_GRID -output=OUTPUT_GRID
+ *        grid_convert --batch [-if=INPUT_FORMAT] -of=OUTPUT_FORMAT -input=DIRECTORY|LIST -output=DIRECTORY [--jobs=N]
  * @author Erwin Meza Vega <emezav@unicauca.edu.co> <emezav@gmail.com>
  * @copyright MIT License
  */
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <map>
 #include <string>
@@ -18,6 +23,9 @@ using std::map;
 using std::string;
 using std::vector;
 
+namespace fs = std::filesystem;
+
+using geo::ConvertTask;
 using geo::Grid;
 using geo::Options;
 using geo::GridFormat;
@@ -31,6 +39,17 @@ using geo::geoStatus;
  */
 void usage(char *program);
 
+/**
+ * @brief Converts all the grids of a directory tree or a list file
+ * @param input Input directory, or text file with one grid path per line
+ * @param iFormat Input format, GridFormat::UNKNOWN to guess it from the extension of each file
+ * @param outputDir Output directory, input subdirectories are kept
+ * @param oFormat Output format
+ * @param jobs Count of files converted at the same time, 0 = all hardware threads
+ * @return EXIT_SUCCESS if all files were converted
+ */
+int convertBatch(const string &input, GridFormat iFormat, const string &outputDir, GridFormat oFormat, int jobs);
+
 int main(int argc, char *argv[])
 {
 
@@ -39,12 +58,17 @@ int main(int argc, char *argv[])
     usage(argv[0]);
   }
   string argString;
+  bool batch = false;
 
   for (int i = 1; i < argc; i++)
   {
     string arg(argv[i]);
-    arg = geo::Strings::replace(arg, "--", "");
-    arg = geo::Strings::replace(arg, "-", "");
+    // Only the dashes before the option name are removed, values keep theirs
+    size_t name = arg.find_first_not_of('-');
+    arg = (name == string::npos) ? "" : arg.substr(name);
+    if (arg == "batch") {
+      batch = true;
+    }
     argString += arg + "\n";
   }
 
@@ -69,6 +93,33 @@ int main(int argc, char *argv[])
   // Get output format
   string outputFormat = options.get("of");
 
+  // Get maximum error (bounded error .geo output)
+  string maxError = options.get("maxerror");
+
+  // Get count of parallel conversions (batch mode)
+  string jobs = options.get("jobs");
+
+  if (batch) {
+    if (!inputFile.length() || !outputFile.length() || !outputFormat.length()) {
+      usage(argv[0]);
+    }
+
+    GridFormat iFormat = inputFormat.length() ? geo::getFormat(inputFormat) : GridFormat::UNKNOWN;
+    GridFormat oFormat = geo::getFormat(outputFormat);
+
+    if (inputFormat.length() && iFormat == GridFormat::UNKNOWN) {
+      cerr << "Unknown input format " << inputFormat << endl;
+      exit(EXIT_FAILURE);
+    }
+
+    if (oFormat == GridFormat::UNKNOWN) {
+      cerr << "Unknown output format " << outputFormat << endl;
+      exit(EXIT_FAILURE);
+    }
+
+    exit(convertBatch(inputFile, iFormat, outputFile, oFormat, atoi(jobs.c_str())));
+  }
+
   if (!inputFile.length() || ! outputFile.length() || ! inputFormat.length() || !outputFormat.length()) {
     usage(argv[0]);
   }
@@ -87,21 +138,35 @@ int main(int argc, char *argv[])
     exit(EXIT_FAILURE);
   }
 
-  Grid grid;
+  geoStatus status;
 
-  // Load input grid
-  geoStatus status = geo::LoadGrid(grid, inputFile, iFormat);
+  // Save output grid
+  if (maxError.length()) {
+    if (oFormat != GridFormat::GEO_TILED) {
+      cerr << "Maximum error requires the geo output format" << endl;
+      exit(EXIT_FAILURE);
+    }
 
-  if (status != geoStatus::SUCCESS) {
-    cerr << "Unable to load input grid";
-    exit(EXIT_FAILURE);
-  }
+    Grid grid;
 
-  // Save output grid
-  status = geo::SaveGrid(grid, outputFile, oFormat);
+    // Load input grid
+    status = geo::LoadGrid(grid, inputFile, iFormat);
+
+    if (status != geoStatus::SUCCESS) {
+      cerr << "Unable to load input grid";
+      exit(EXIT_FAILURE);
+    }
+
+    status = geo::GeoTiled::save(grid, outputFile, geo::GeoTiled::defaultTileSize, -1,
+                                 geo::GeoTiled::Codec::LOSSY, atof(maxError.c_str()));
+  } else {
+    // Stream blocks of rows from the input to the output
+    status = geo::ConvertGrid(inputFile, iFormat, outputFile, oFormat);
+  }
 
   if (status != geoStatus::SUCCESS) {
     cerr << "Unable to create output grid " << outputFile << endl;
+    exit(EXIT_FAILURE);
   }
 
   exit(EXIT_SUCCESS);
@@ -112,8 +177,13 @@ void usage(char *program)
 {
   cerr
       << "Usage: "
-      << program << " -if|--if=INPUT_FORMAT -of|--of=OUTPUT_FORMAT -i|--input=INPUT_GRID -o|--output=OUTPUT_FILE" << endl
+      << program << " -if|--if=INPUT_FORMAT -of|--of=OUTPUT_FORMAT -i|--input=INPUT_GRID -o|--output=OUTPUT_FILE [--maxerror=E]" << endl
+      << "       " << program << " --batch [-if|--if=INPUT_FORMAT] -of|--of=OUTPUT_FORMAT -i|--input=DIRECTORY|LIST -o|--output=DIRECTORY [--jobs=N]" << endl
       << " Converts INPUT_GRID (INPUT_FORMAT) to OUTPUT_GRID(OUTPUT_FORMAT)" << endl
+      << " --maxerror=E stores geo output with an absolute error below E on each cell" << endl
+      << " --batch converts every grid of DIRECTORY (and subdirectories) or every path listed on LIST" << endl
+      << "   into the output DIRECTORY, N files at a time (default: all hardware threads), largest files first." << endl
+      << "   Input formats are guessed from the extensions when INPUT_FORMAT is not given." << endl
       << " Available formats:" << endl
       << "   esriAscii        ESRI ASCII .asc" << endl
       << "   esri             ESRI binary (float) .bil" << endl
@@ -122,8 +192,149 @@ void usage(char *program)
       << "   surferAscii      Surfer 6 ASCII .grd" << endl
       << "   surfer6          Surfer 6 binary (float) .grd" << endl
       << "   surfer7          Surfer 7 binary (double) .grd" << endl
+      << "   geo              Native tiled grid .geo" << endl
       << "   txt              Headerless first row first .txt" << endl
       << "   txtReverse       Headerless last row first .txt" << endl;
 
     exit(EXIT_SUCCESS);
-}
\ No newline at end of file
+}
+int convertBatch(const string &input, GridFormat iFormat, const string &outputDir, GridFormat oFormat, int jobs)
+{
+  vector<ConvertTask> tasks;
+
+  // Output files keep the path relative to the input directory
+  auto addTask = [&](const fs::path &path, const fs::path &relative) {
+    GridFormat format = geo::getFormatFromPath(path.string());
+
+    if (iFormat != GridFormat::UNKNOWN) {
+      string extension = path.extension().string();
+      if (Strings::tolower(extension) != geo::getExtension(iFormat)) {
+        return;
+      }
+      format = iFormat;
+    }
+
+    if (format == GridFormat::UNKNOWN) {
+      return;
+    }
+
+    fs::path output = fs::path(outputDir) / relative;
+    output.replace_extension(geo::getExtension(oFormat));
+
+    tasks.push_back({path.string(), format, output.string(), oFormat});
+  };
+
+  // Overview sidecars (dem.ovr2.bil, see geo::OverviewPath) belong to their grid
+  auto isOverview = [](const fs::path &path) {
+    string suffix = path.stem().extension().string();
+    return suffix.size() > 4 && suffix.compare(0, 4, ".ovr") == 0 &&
+           suffix.find_first_not_of("0123456789", 4) == string::npos;
+  };
+
+  if (fs::is_directory(input)) {
+    for (const auto &entry : fs::recursive_directory_iterator(input)) {
+      if (entry.is_regular_file() && !isOverview(entry.path())) {
+        addTask(entry.path(), fs::relative(entry.path(), input));
+      }
+    }
+  } else {
+    std::ifstream list(input);
+    if (!list) {
+      cerr << "Unable to open " << input << endl;
+      return EXIT_FAILURE;
+    }
+    vector<fs::path> paths;
+    string line;
+    while (std::getline(list, line)) {
+      geo::Strings::trim(line);
+      if (line.length()) {
+        paths.push_back(fs::absolute(line).lexically_normal());
+      }
+    }
+
+    // Paths are kept relative to the deepest directory that contains all the files
+    fs::path root = paths.empty() ? fs::path() : paths.front().parent_path();
+    for (const fs::path &path : paths) {
+      fs::path common;
+      auto r = root.begin();
+      for (auto p = path.begin(); r != root.end() && p != path.end() && *r == *p; ++r, ++p) {
+        common /= *r;
+      }
+      root = common;
+    }
+
+    for (const fs::path &path : paths) {
+      addTask(path, path.lexically_relative(root));
+    }
+  }
+
+  if (tasks.empty()) {
+    cerr << "No grids to convert on " << input << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Files of a grid: data, and the header of ESRI binary and ENVI grids
+  auto files = [](const string &path, GridFormat format) {
+    fs::path data = fs::weakly_canonical(path);
+    vector<string> result{data.string()};
+    if (format == GridFormat::ESRI_FLOAT || format == GridFormat::ENVI_FLOAT || format == GridFormat::ENVI_DOUBLE) {
+      result.push_back(fs::path(data).replace_extension(".hdr").string());
+    }
+    return result;
+  };
+
+  // Each output is written once, and never over an input
+  map<string, string> inputs;
+  map<string, string> outputs;
+  for (const auto &task : tasks) {
+    for (const string &file : files(task.input, task.inputFormat)) {
+      inputs[file] = task.input;
+    }
+  }
+
+  for (const auto &task : tasks) {
+    for (const string &file : files(task.output, task.outputFormat)) {
+      if (inputs.count(file)) {
+        cerr << task.input << " -> " << task.output << " would overwrite " << file << " of " << inputs[file] << endl;
+        return EXIT_FAILURE;
+      }
+      if (outputs.count(file)) {
+        cerr << task.input << " and " << outputs[file] << " are both converted to " << file << endl;
+        return EXIT_FAILURE;
+      }
+    }
+    for (const string &file : files(task.output, task.outputFormat)) {
+      outputs[file] = task.input;
+    }
+  }
+
+  for (const auto &task : tasks) {
+    fs::create_directories(fs::path(task.output).parent_path());
+  }
+
+  uintmax_t totalBytes = 0;
+  int failures = 0;
+
+  auto start = std::chrono::steady_clock::now();
+
+  geoStatus status = geo::ConvertGrids(tasks, jobs, [&](const ConvertTask &task) {
+    totalBytes += task.size;
+    if (task.status != geoStatus::SUCCESS) {
+      failures++;
+      cerr << task.input << " -> " << task.output << " FAILED" << endl;
+      return;
+    }
+    cout << task.input << " -> " << task.output << std::fixed << std::setprecision(2)
+         << " " << task.size / (1024.0 * 1024.0) << " MB "
+         << task.seconds << " s "
+         << task.throughput() << " MB/s" << endl;
+  });
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  cout << tasks.size() - failures << " of " << tasks.size() << " files converted, "
+       << std::fixed << std::setprecision(2) << totalBytes / (1024.0 * 1024.0) << " MB in "
+       << seconds << " s (" << ((seconds > 0.0) ? totalBytes / (1024.0 * 1024.0) / seconds : 0.0) << " MB/s)" << endl;
+
+  return (status == geoStatus::SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,12 +1,14 @@
 /**
  * @file
  * @brief Grid diff
- * Usage: grid_diff file1 file2 [rpe showAll]
+ * Usage: grid_diff file1 file2 [rpe showAll|any] [--difference=PATH] [--mask=PATH] [--stream] [--hashes]
  * @author Erwin Meza Vega <emezav@unicauca.edu.co> <emezav@gmail.com>
  * @copyright MIT License
  */
 
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <map>
 #include <string>
 #include <vector>
@@ -18,6 +20,7 @@ using std::map;
 using std::string;
 using std::vector;
 
+using geo::CompareMode;
 using geo::Grid;
 using geo::Options;
 using geo::GridFormat;
@@ -36,33 +39,134 @@ void usage(char *program);
  * @param gridB second grid
  * @param rpe Relative Percent Error (maximum allowed difference, percent)
  * @param showAll Show all differences
+ * @param differencePath Path of the A - B grid, empty for none
+ * @param maskPath Path of the different cells mask, empty for none
  */
-void diff(const Grid & gridA, const Grid & gridB, float rpe=1.0f, bool showAll = false);
+void diff(const Grid & gridA, const Grid & gridB, float rpe=1.0f, bool showAll = false,
+          const string &differencePath = "", const string &maskPath = "");
+
+/**
+ * @brief Compares two grid files by blocks of rows, without loading them
+ * @param pathA first grid
+ * @param pathB second grid
+ * @param rpe Relative Percent Error (maximum allowed difference, percent)
+ * @param showAll Show all differences
+ * @return EXIT_SUCCESS if both grids were read
+ */
+int streamDiff(const string &pathA, const string &pathB, float rpe, bool showAll);
+
+/**
+ * @brief Prints the first different cells and the statistics, in one write
+ * @param result Statistics
+ * @param differences First different cells
+ * @param showAll true if all the different cells are listed
+ */
+void report(const geo::GridDiff &result, const vector<geo::DiffCell> &differences, bool showAll);
+
+/**
+ * @brief Saves a difference raster, the format is deduced from the file extension
+ * @param grid Difference raster
+ * @param path Output path
+ */
+void saveRaster(const Grid &grid, const string &path);
 
 int main(int argc, char *argv[])
 {
 
+  // Output rasters, the other arguments are positional
+  string differencePath;
+  string maskPath;
+  bool stream = false;
+  bool buildHashes = false;
+  vector<string> args;
+
+  for (int i = 0; i < argc; i++)
+  {
+    string arg(argv[i]);
+    if (arg.rfind("--difference=", 0) == 0) {
+      differencePath = arg.substr(13);
+    } else if (arg.rfind("--mask=", 0) == 0) {
+      maskPath = arg.substr(7);
+    } else if (arg == "--stream") {
+      stream = true;
+    } else if (arg == "--hashes") {
+      buildHashes = true;
+    } else {
+      args.push_back(arg);
+    }
+  }
+
+  argc = static_cast<int>(args.size());
+
   if (argc < 3)
   {
     usage(argv[0]);
   }
 
-  string pathA(argv[1]);
-  string pathB(argv[2]);
+  string pathA(args[1]);
+  string pathB(args[2]);
 
   bool showAll = false;
 
   float rpe{1.0f};
   // Check if rpe was provided
   if (argc >= 4) {
-    rpe = std::strtof(argv[3], nullptr);
+    rpe = std::strtof(args[3].c_str(), nullptr);
   }
 
   // Check if showAll was provided after rpe
-  if (argc >= 5 && string(argv[4]).compare("true") == 0) {
+  if (argc >= 5 && args[4].compare("true") == 0) {
     showAll = true;
   }
 
+  // Only check if there are differences, exit status 1 if there are
+  bool any = (argc >= 5 && args[4].compare("any") == 0);
+
+  if (buildHashes) {
+    for (const string &path : {pathA, pathB}) {
+      geo::GridHashes hashes;
+      if (geo::LoadHashes(path, hashes) != geoStatus::SUCCESS && geo::BuildHashes(path) != geoStatus::SUCCESS) {
+        cerr << "Unable to build the hashes of " << path << endl;
+      }
+    }
+  }
+
+  // Equal hash sidecars, the grids are not read
+  if (any && rpe > 0.0f && geo::IdenticalGrids(pathA, pathB)) {
+    cout << "Grids are equal." << endl;
+    exit(EXIT_SUCCESS);
+  }
+
+  // With up to date sidecars only the blocks with different hashes are read
+  geo::GridHashes hashesA, hashesB;
+  if (!stream && !differencePath.length() && !maskPath.length() && rpe > 0.0f &&
+      geo::LoadHashes(pathA, hashesA) == geoStatus::SUCCESS && geo::LoadHashes(pathB, hashesB) == geoStatus::SUCCESS &&
+      hashesA.comparable(hashesB)) {
+    stream = true;
+  }
+
+  // Only the blocks up to the first one with differences are read, the grids are not loaded
+  if (any) {
+    geo::GridDiff result;
+    if (geo::DiffGrids(pathA, pathB, CompareMode::RELATIVE, rpe, result, nullptr, 0, 0, 0, true) != geoStatus::SUCCESS) {
+      cerr << "Unable to compare the grids" << endl;
+      exit(EXIT_FAILURE);
+    }
+    // Grids with different dimensions have no compared cells
+    bool different = (result.different > 0 || result.cells == 0);
+    cout << (different ? "Grids are different." : "Grids are equal.") << endl;
+    exit(different ? EXIT_FAILURE : EXIT_SUCCESS);
+  }
+
+  // Read both files by blocks of rows instead of loading them
+  if (stream) {
+    if (differencePath.length() || maskPath.length()) {
+      cerr << "Difference rasters require loading the grids" << endl;
+      exit(EXIT_FAILURE);
+    }
+    exit(streamDiff(pathA, pathB, rpe, showAll));
+  }
+
   Grid gridA, gridB;
 
   // Load first grid
@@ -81,7 +185,7 @@ int main(int argc, char *argv[])
     exit(EXIT_FAILURE);
   }
 
-  diff(gridA, gridB, rpe, showAll);
+  diff(gridA, gridB, rpe, showAll, differencePath, maskPath);
 
   exit(EXIT_SUCCESS);
 
@@ -91,42 +195,115 @@ void usage(char *program)
 {
   cerr
       << "Usage: "
-      << program << " gridA gridB [rpe(1-100) showAll]" << endl
+      << program << " gridA gridB [rpe(1-100) showAll|any] [--difference=PATH] [--mask=PATH] [--stream] [--hashes]" << endl
       << " Compares two grids and prints differences: row,column,valueA,valueB" << endl
+      << " and the error statistics of the cells with data on both grids." << endl
       << " rpe is desired Relative Percent Error, defaults to 1 percent." << endl
       << " set showAll to true to show all diffs." << endl
+      << " set showAll to any to stop on the first difference: exit status is 1 if the grids differ." << endl
+      << " --difference=PATH saves A - B, --mask=PATH saves 1 on the different cells (format from the extension)." << endl
+      << " --stream reads both grids by blocks of rows instead of loading them, for grids larger than memory." << endl
+      << " --hashes builds the missing hash sidecars (GRID.hash) of both grids. With up to date sidecars," << endl
+      << " blocks with equal hashes are not read, and grids with equal hashes are not read at all." << endl
       << " Grid format will be deduced from the file extension.";
 
     exit(EXIT_SUCCESS);
 }
 
-void diff(const Grid & gridA, const Grid & gridB, float rpe, bool showAll) {
+void diff(const Grid & gridA, const Grid & gridB, float rpe, bool showAll,
+          const string &differencePath, const string &maskPath) {
 
   if (!gridA.equalDimensions(gridB)) {
     cout << "Dimensions are different." << endl;
     return;
   }
 
-  auto [rows, columns] = gridA.dimensions();
+  // Statistics and listing on one pass over both grids, with the same NODATA rules
+  vector<geo::DiffCell> cells;
+  geo::GridDiff result = gridA.diff(gridB, CompareMode::RELATIVE, rpe, cells,
+                                    showAll ? std::numeric_limits<size_t>::max() : 100);
 
-  int count = 0;
-  for (int i = 0; i < rows; i++) {
-    for (int j = 0; j < columns; j++) {
-      if (!gridA.equalsAt(gridB, i, j, rpe)) {
-        if (count++ < 100 || showAll) {
-        // Show difference
-        cout << i << "," << j <<": "<<gridA(i,j) << " <-> " << gridB(i,j) << endl;
-        }
-      }
-    }
+  Grid raster;
+
+  if (differencePath.length()) {
+    gridA.diff(gridB, CompareMode::RELATIVE, rpe, geo::DiffRaster::DIFFERENCE, raster, 0);
+    saveRaster(raster, differencePath);
   }
 
-  if (count > 100 && !showAll) {
-    cout << "..." << endl;
+  if (maskPath.length()) {
+    gridA.diff(gridB, CompareMode::RELATIVE, rpe, geo::DiffRaster::MASK, raster, 0);
+    saveRaster(raster, maskPath);
   }
 
-  if (count) {
-    cout << count <<" total positions are different." << endl;
+  report(result, cells, showAll);
+
+}
+
+int streamDiff(const string &pathA, const string &pathB, float rpe, bool showAll) {
+
+  geo::GridDiff result;
+  vector<geo::DiffCell> cells;
+
+  if (geo::DiffGrids(pathA, pathB, CompareMode::RELATIVE, rpe, result, &cells,
+                     showAll ? std::numeric_limits<size_t>::max() : 100) != geoStatus::SUCCESS) {
+    cerr << "Unable to read the grids" << endl;
+    return EXIT_FAILURE;
   }
 
-}
\ No newline at end of file
+  if (!result.valid()) {
+    cout << "Dimensions are different." << endl;
+    return EXIT_SUCCESS;
+  }
+
+  report(result, cells, showAll);
+
+  return EXIT_SUCCESS;
+}
+
+void report(const geo::GridDiff &result, const vector<geo::DiffCell> &differences, bool showAll) {
+
+  // The listing is written at once
+  std::ostringstream listing;
+
+  for (const geo::DiffCell &cell : differences) {
+    // Show difference
+    listing << cell.row << "," << cell.column <<": "<< cell.a << " <-> " << cell.b << '\n';
+  }
+
+  if (result.different > 100 && !showAll) {
+    listing << "..." << '\n';
+  }
+
+  if (result.different) {
+    listing << result.different <<" total positions are different." << '\n';
+  }
+
+  listing << "Cells: " << result.cells << ", compared: " << result.compared
+          << ", NODATA on one grid: " << result.noDataMismatches << '\n'
+          << "Max error: " << result.maxError << ", mean error: " << result.meanError
+          << ", mean absolute error: " << result.meanAbsoluteError << ", RMSE: " << result.rmse << '\n'
+          << "Relative percent error:" << '\n';
+
+  const auto &limits = geo::GridDiff::relativeErrorLimits;
+  for (size_t bin = 0; bin < result.relativeErrors.size(); bin++) {
+    listing << "  " << ((bin < limits.size()) ? "< " : ">=") << std::setw(6)
+            << ((bin < limits.size()) ? limits[bin] : limits.back()) << "% " << result.relativeErrors[bin] << '\n';
+  }
+
+  if (result.worst.size()) {
+    listing << "Largest errors:" << '\n';
+    for (const geo::DiffCell &cell : result.worst) {
+      listing << "  " << cell.row << "," << cell.column << ": " << cell.a << " <-> " << cell.b
+              << " (" << cell.error << ")" << '\n';
+    }
+  }
+
+  cout << listing.str() << std::flush;
+
+}
+
+void saveRaster(const Grid &grid, const string &path) {
+  if (geo::SaveGrid(grid, path, geo::getFormatFromPath(path)) != geoStatus::SUCCESS) {
+    cerr << "Unable to create output grid " << path << endl;
+  }
+}
@@ -138,7 +138,8 @@ void usage(char *program)
       << "   enviDouble       ENVI binary (double) .flt" << endl
       << "   surferAscii      Surfer 6 ASCII .grd" << endl
       << "   surfer6          Surfer 6 binary (float) .grd" << endl
-      << "   surfer7          Surfer 7 binary (double) .grd" << endl;
+      << "   surfer7          Surfer 7 binary (double) .grd" << endl
+      << "   geo              Native tiled grid .geo" << endl;
 
   exit(EXIT_SUCCESS);
 }
@@ -2,10 +2,13 @@
  * @file
  * @brief Position inside a grid
  * Usage: grid_position grid lon lat
+ *        grid_position grid < points
  * @author Erwin Meza Vega <emezav@unicauca.edu.co> <emezav@gmail.com>
  * @copyright MIT License
  */
 
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <map>
 #include <string>
@@ -19,6 +22,7 @@ using std::string;
 using std::vector;
 
 using geo::Grid;
+using geo::GridInfo;
 using geo::Options;
 using geo::GridFormat;
 using geo::Strings;
@@ -31,24 +35,37 @@ using geo::geoStatus;
  */
 void usage(char *program);
 
+/**
+ * @brief Samples the grid at the lon lat pairs read from stdin, one pair per line
+ * @param path Grid path
+ * @return EXIT_SUCCESS if the grid was loaded
+ */
+int samplePoints(const string &path);
+
 int main(int argc, char *argv[])
 {
 
+  if (argc == 2)
+  {
+    exit(samplePoints(string(argv[1])));
+  }
+
   if (argc != 4)
   {
     usage(argv[0]);
   }
 
-  Grid grid;
+  // Only the header is needed to locate the coordinates
+  geo::GridInfo info = geo::ProbeGrid(string(argv[1]));
 
-  if (geo::LoadGrid(grid, string(argv[1])) != geoStatus::SUCCESS) {
+  if (!info.valid()) {
     cerr << "Unable to open input grid" << endl;
     exit(EXIT_FAILURE);
   }
 
-  auto [i,j] = grid.position(atof(argv[2]), atof(argv[3]));
-  auto [rows, columns] = grid.dimensions();
-  cout << "Input coordinates: " << argv[1] <<"," << argv[2] << endl
+  auto [i,j] = info.position(atof(argv[2]), atof(argv[3]));
+  auto [rows, columns] = info.dimensions();
+  cout << "Input coordinates: " << argv[2] <<"," << argv[3] << endl
        << "Position: " << i<<","<< j<< " Inverse row: " << i << "," << rows - j << endl;
 
 
@@ -61,7 +78,63 @@ void usage(char *program)
   cerr
       << "Usage: "
       << program << " grid lon lat" << endl
-      << " Calculates the column (longitude) and row (latitude) position inside a grid for the given lon,lat coordinates" << endl;
+      << " Calculates the column (longitude) and row (latitude) position inside a grid for the given lon,lat coordinates" << endl
+      << program << " grid < points" << endl
+      << " Reads lon lat pairs from stdin (one per line, separated by spaces or commas)" << endl
+      << " and prints lon lat value for each one, nan outside the grid or on NODATA cells" << endl;
 
     exit(EXIT_SUCCESS);
-}
\ No newline at end of file
+}
+int samplePoints(const string &path)
+{
+  Grid grid;
+
+  // ESRI/ENVI float grids are mapped, pages are read as points reach them
+  if (geo::LoadGrid(grid, path, true) != geoStatus::SUCCESS) {
+    cerr << "Unable to open input grid" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Points are sampled in batches
+  const size_t batchSize = 1 << 16;
+  vector<double> lon;
+  vector<double> lat;
+  vector<float> values(batchSize);
+  lon.reserve(batchSize);
+  lat.reserve(batchSize);
+
+  auto flush = [&]() {
+    grid.sample(lon.data(), lat.data(), lon.size(), values.data());
+    for (size_t i = 0; i < lon.size(); i++) {
+      printf("%.9f %.9f %.9g\n", lon[i], lat[i], values[i]);
+    }
+    lon.clear();
+    lat.clear();
+  };
+
+  char line[256];
+  while (fgets(line, sizeof(line), stdin) != nullptr) {
+    char *end;
+    double x = strtod(line, &end);
+    if (end == line) {
+      continue;
+    }
+    char *pos = end;
+    while (*pos == ',' || *pos == ' ' || *pos == '\t') {
+      pos++;
+    }
+    double y = strtod(pos, &end);
+    if (end == pos) {
+      continue;
+    }
+
+    lon.push_back(x);
+    lat.push_back(y);
+    if (lon.size() == batchSize) {
+      flush();
+    }
+  }
+  flush();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file
+ * @brief Grid resampling
+ * Usage: grid_resample -i=INPUT_GRID -o=OUTPUT_GRID [-of=OUTPUT_FORMAT] -method=METHOD (--dx=DX --dy=DY | --rows=ROWS --columns=COLUMNS)
+ *        grid_resample --overviews -i=INPUT_GRID [-method=METHOD] [--levels=N]
+ * @author Erwin Meza Vega <emezav@unicauca.edu.co> <emezav@gmail.com>
+ * @copyright MIT License
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "geo.h"
+
+using std::cout;
+using std::endl;
+using std::map;
+using std::string;
+using std::vector;
+
+using geo::Grid;
+using geo::Options;
+using geo::GridFormat;
+using geo::ResampleMethod;
+using geo::Strings;
+using geo::geoStatus;
+
+
+/**
+ * @brief Prints program usage
+ * @param program Program
+ */
+void usage(char *program);
+
+int main(int argc, char *argv[])
+{
+
+  if (argc == 1)
+  {
+    usage(argv[0]);
+  }
+  string argString;
+  bool overviews = false;
+
+  for (int i = 1; i < argc; i++)
+  {
+    string arg(argv[i]);
+    arg = geo::Strings::replace(arg, "--", "");
+    arg = geo::Strings::replace(arg, "-", "");
+    if (arg == "overviews") {
+      overviews = true;
+    }
+    argString += arg + "\n";
+  }
+
+  // Parse command line options
+  Options options(argString);
+
+  // Get input file
+  string inputFile = options.get("input");
+  if (!inputFile.length()) {
+    inputFile = options.get("i");
+  }
+
+  // Get output file
+  string outputFile = options.get("output");
+  if (!outputFile.length()) {
+    outputFile = options.get("o");
+  }
+
+  // Get output format, guessed from the output extension by default
+  string outputFormat = options.get("of");
+
+  // Get method and target resolution or size
+  string methodName = options.get("method");
+  string dx = options.get("dx");
+  string dy = options.get("dy");
+  string rows = options.get("rows");
+  string columns = options.get("columns");
+
+  // Build the overview pyramid next to the input grid
+  if (overviews) {
+    if (!inputFile.length()) {
+      usage(argv[0]);
+    }
+
+    ResampleMethod method = methodName.length() ? geo::getResampleMethod(methodName) : ResampleMethod::AVERAGE;
+
+    if (geo::BuildOverviews(inputFile, method, atoi(options.get("levels").c_str())) != geoStatus::SUCCESS) {
+      cerr << "Unable to build the overviews of " << inputFile << endl;
+      exit(EXIT_FAILURE);
+    }
+
+    exit(EXIT_SUCCESS);
+  }
+
+  bool byResolution = dx.length() && dy.length();
+  bool bySize = rows.length() && columns.length();
+
+  if (!inputFile.length() || !outputFile.length() || !methodName.length() || byResolution == bySize) {
+    usage(argv[0]);
+  }
+
+  ResampleMethod method = geo::getResampleMethod(methodName);
+
+  if (method == ResampleMethod::UNKNOWN) {
+    cerr << "Unknown method " << methodName << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  GridFormat oFormat = outputFormat.length() ? geo::getFormat(outputFormat) : geo::getFormatFromPath(outputFile);
+
+  if (oFormat == GridFormat::UNKNOWN) {
+    cerr << "Unknown output format " << (outputFormat.length() ? outputFormat : outputFile) << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  Grid grid;
+
+  // Source rows are read from the mapping as they are needed
+  if (geo::LoadGrid(grid, inputFile, true) != geoStatus::SUCCESS) {
+    cerr << "Unable to load input grid " << inputFile << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  Grid resampled = byResolution ? grid.resample(atof(dx.c_str()), atof(dy.c_str()), method)
+                                : grid.resample(atoi(rows.c_str()), atoi(columns.c_str()), method);
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  auto [outputRows, outputColumns] = resampled.dimensions();
+
+  if (outputRows == 0) {
+    cerr << "Unable to resample " << inputFile << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (geo::SaveGrid(resampled, outputFile, oFormat) != geoStatus::SUCCESS) {
+    cerr << "Unable to create output grid " << outputFile << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cout << inputFile << " -> " << outputFile << " " << outputRows << " x " << outputColumns
+       << " in " << seconds << " s" << endl;
+
+  exit(EXIT_SUCCESS);
+
+}
+
+void usage(char *program)
+{
+  cerr
+      << "Usage: "
+      << program << " -i|--input=INPUT_GRID -o|--output=OUTPUT_GRID [-of|--of=OUTPUT_FORMAT] --method=METHOD (--dx=DX --dy=DY | --rows=ROWS --columns=COLUMNS)" << endl
+      << " Resamples INPUT_GRID to a resolution (DX, DY in decimal degrees) or to a size (ROWS x COLUMNS)" << endl
+      << " covering the same extents. OUTPUT_FORMAT is guessed from the extension of OUTPUT_GRID when not given." << endl
+      << "       " << program << " --overviews -i|--input=INPUT_GRID [--method=average|min|max] [--levels=N]" << endl
+      << " Builds N overview levels (2x, 4x, 8x...) next to INPUT_GRID, by default until they fit in 256 x 256 cells." << endl
+      << " Methods:" << endl
+      << "   nearest          Source cell that contains the center of the target cell" << endl
+      << "   bilinear         Bilinear interpolation at the center of the target cell" << endl
+      << "   average          Average of the source cells inside the target cell" << endl
+      << "   min              Minimum of the source cells inside the target cell" << endl
+      << "   max              Maximum of the source cells inside the target cell" << endl
+      << "   mode             Most frequent value of the source cells inside the target cell" << endl
+      << " NODATA source cells are left out." << endl;
+
+    exit(EXIT_SUCCESS);
+}
@@ -1,3 +1,6 @@
+#include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include <filesystem>
 #include <gtest/gtest.h>
@@ -69,6 +72,311 @@ TEST(DataSetTest, LoadingDatasets)
 }
 
 
+// Number parsing matches strtod on the "C" locale
+TEST(DataSetTest, ParsingNumbers)
+{
+  const vector<string> tokens{
+      "0", "-0", "42", "+42", "-9999", "123456789", "3.1415927", "-0.000001",
+      "1e10", "-2.5E-3", ".5", "7.", "12345678901234567890", "1e-50", "1e50", "nan", "-inf"};
+
+  for (const auto &token : tokens)
+  {
+    float value{};
+    const char *end = geo::Numbers::parse(token.data(), token.data() + token.size(), value);
+    EXPECT_EQ(end, token.data() + token.size()) << token;
+
+    float expected = std::strtof(token.c_str(), nullptr);
+    if (std::isnan(expected))
+    {
+      EXPECT_TRUE(std::isnan(value)) << token;
+    }
+    else
+    {
+      EXPECT_EQ(value, expected) << token;
+    }
+  }
+
+  // Invalid tokens are not consumed
+  const string invalid("abc");
+  float value{};
+  EXPECT_EQ(geo::Numbers::parse(invalid.data(), invalid.data() + invalid.size(), value), invalid.data());
+
+  // Integral types are rounded and clamped, as castCell does
+  int intValue{};
+  const string decimal("-12.75");
+  geo::Numbers::parse(decimal.data(), decimal.data() + decimal.size(), intValue);
+  EXPECT_EQ(intValue, -13);
+  int16_t shortValue{};
+  const string large("40000");
+  geo::Numbers::parse(large.data(), large.data() + large.size(), shortValue);
+  EXPECT_EQ(shortValue, 32767);
+}
+
+// Text loading throughput, NODATA runs and mixed tokens
+TEST(DataSetTest, LoadingTextThroughput)
+{
+  // Use "data/" folder
+  fs::path currentPath(fs::current_path() / "data");
+  fs::create_directories(currentPath);
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const string strPath = (currentPath / "throughput.txt").string();
+
+  int rows = 2000;
+  int columns = 1000;
+
+  // Elevations with 3 decimals and NODATA runs
+  FILE *fp = fopen(strPath.c_str(), "w");
+  ASSERT_NE(fp, nullptr);
+  for (int i = 0; i < rows; i++)
+  {
+    for (int j = 0; j < columns; j++)
+    {
+      if (j < columns / 4)
+      {
+        fprintf(fp, "-9999 ");
+      }
+      else
+      {
+        fprintf(fp, "%.3f ", (i * columns + j) / 8.0f);
+      }
+    }
+    fprintf(fp, "\n");
+  }
+  fclose(fp);
+
+  size_t fileSize = fs::file_size(strPath);
+
+  // One core, as the target
+  geo::setThreads(1);
+  auto start = std::chrono::steady_clock::now();
+  auto [status, count, data] = FloatDataSet::loadText(strPath);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  geo::setThreads(0);
+
+  ASSERT_EQ(status, geo::geoStatus::SUCCESS);
+  ASSERT_EQ(count, static_cast<size_t>(rows) * columns);
+
+  for (int i = 0; i < rows; i++)
+  {
+    for (int j = 0; j < columns; j++)
+    {
+      float expected = (j < columns / 4) ? -9999.0f : std::strtof(std::to_string((i * columns + j) / 8.0f).c_str(), nullptr);
+      ASSERT_NEAR(data[i * columns + j], expected, 1e-3f * std::max(1.0f, std::fabs(expected)));
+    }
+  }
+  free(data);
+
+  double throughput = fileSize / (1024.0 * 1024.0) / elapsed.count();
+  cout << "Parsed " << fileSize << " bytes at " << throughput << " MB/s" << endl;
+  RecordProperty("throughput_mb_s", std::to_string(throughput));
+
+#ifdef NDEBUG
+  // Optimized builds only. Target is 250 MB/s (about 270 MB/s measured),
+  // the floor leaves room for loaded machines and still catches slow paths
+  EXPECT_GE(throughput, 100.0);
+#endif
+}
+
+// Parallel text loading matches serial loading
+TEST(DataSetTest, LoadingTextParallel)
+{
+  // Use "data/" folder
+  fs::path currentPath(fs::current_path() / "data");
+  fs::create_directories(currentPath);
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const string strPath = (currentPath / "parallel.txt").string();
+
+  // About 16 MB: 4 chunks of at least parallelChunkSize bytes
+  int n = 2000000;
+  float *data = createSequentialData(n);
+  ASSERT_NE(data, nullptr);
+  for (int i = 0; i < n; i += 7)
+  {
+    data[i] = -9999.0f;
+  }
+  ASSERT_EQ(FloatDataSet::saveText(strPath, data, n, 1000), geo::geoStatus::SUCCESS);
+  ASSERT_GE(fs::file_size(strPath), 4 * FloatDataSet::parallelChunkSize);
+
+  geo::setThreads(4);
+  auto [status, count, parallelData] = FloatDataSet::loadText(strPath);
+  geo::setThreads(1);
+  auto [serialStatus, serialCount, serialData] = FloatDataSet::loadText(strPath);
+  geo::setThreads(0);
+
+  ASSERT_EQ(status, geo::geoStatus::SUCCESS);
+  ASSERT_EQ(serialStatus, geo::geoStatus::SUCCESS);
+  ASSERT_EQ(count, static_cast<size_t>(n));
+  ASSERT_EQ(serialCount, count);
+  EXPECT_EQ(memcmp(parallelData, data, n * sizeof(float)), 0);
+  EXPECT_EQ(memcmp(serialData, data, n * sizeof(float)), 0);
+
+  free(parallelData);
+  free(serialData);
+
+  // Slices are split on the size of the file, not on the estimate of the caller
+  FILE *estimated = fopen(strPath.c_str(), "r");
+  ASSERT_NE(estimated, nullptr);
+  geo::setThreads(4);
+  auto [estimatedStatus, estimatedCount, estimatedData] = FloatDataSet::loadText(estimated, fs::file_size(strPath) / 2);
+  geo::setThreads(0);
+  fclose(estimated);
+  ASSERT_EQ(estimatedStatus, geo::geoStatus::SUCCESS);
+  ASSERT_EQ(estimatedCount, static_cast<size_t>(n));
+  EXPECT_EQ(memcmp(estimatedData, data, n * sizeof(float)), 0);
+  free(estimatedData);
+
+  // Invalid chars fall back to the serial parser, which skips them
+  FILE *fp = fopen(strPath.c_str(), "r+");
+  ASSERT_NE(fp, nullptr);
+  fseek(fp, 0, SEEK_SET);
+  fputc('x', fp);
+  fclose(fp);
+
+  geo::setThreads(4);
+  auto [invalidStatus, invalidCount, invalidData] = FloatDataSet::loadText(strPath);
+  geo::setThreads(0);
+
+  ASSERT_EQ(invalidStatus, geo::geoStatus::SUCCESS);
+  EXPECT_EQ(invalidCount, static_cast<size_t>(n));
+  EXPECT_EQ(memcmp(invalidData + 1, data + 1, (n - 1) * sizeof(float)), 0);
+
+  free(invalidData);
+  free(data);
+}
+
+// Text output formats
+TEST(DataSetTest, SavingTextFormats)
+{
+  // Use "data/" folder
+  fs::path currentPath(fs::current_path() / "data");
+  fs::create_directories(currentPath);
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const string fixedPath = (currentPath / "fixed.txt").string();
+  const string printfPath = (currentPath / "printf.txt").string();
+
+  // Values of all magnitudes, plus integral, NODATA and special values
+  int n = 100000;
+  int lineSize = 100;
+  vector<float> data(n);
+  uint32_t seed = 12345;
+  for (int i = 0; i < n; i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    float value;
+    uint32_t bits = (seed & 0x807fffffu) | ((100u + (seed % 60u)) << 23);
+    memcpy(&value, &bits, sizeof(value));
+    data[i] = (i % 5 == 0) ? std::round(value) : value;
+  }
+  data[1] = -9999.0f;
+  data[2] = NAN;
+  data[3] = INFINITY;
+  data[4] = -0.0f;
+
+  // Same output as fprintf("%.7f") on the reversed batches
+  ASSERT_EQ(FloatDataSet::saveTextReverseBatches(fixedPath, data.data(), n, lineSize), geo::geoStatus::SUCCESS);
+
+  FILE *fp = fopen(printfPath.c_str(), "wb");
+  ASSERT_NE(fp, nullptr);
+  for (int i = n / lineSize - 1; i >= 0; i--)
+  {
+    for (int j = 0; j < lineSize; j++)
+    {
+      fprintf(fp, j == 0 ? "%.7f" : " %.7f", data[i * lineSize + j]);
+    }
+    fprintf(fp, "\n");
+  }
+  fclose(fp);
+
+  std::ifstream fixedFile(fixedPath, std::ios::binary);
+  std::ifstream printfFile(printfPath, std::ios::binary);
+  string fixedText((std::istreambuf_iterator<char>(fixedFile)), std::istreambuf_iterator<char>());
+  string printfText((std::istreambuf_iterator<char>(printfFile)), std::istreambuf_iterator<char>());
+  EXPECT_EQ(fixedText, printfText);
+
+  // Compact and shortest output read back to the same values, in smaller files
+  for (auto textFormat : {geo::TextFormat::COMPACT, geo::TextFormat::SHORTEST})
+  {
+    const string path = (currentPath / "compact.txt").string();
+
+    geo::setTextFormat(textFormat);
+    ASSERT_EQ(FloatDataSet::saveText(path, data.data(), n, lineSize), geo::geoStatus::SUCCESS);
+    geo::setTextFormat(geo::TextFormat::FIXED);
+
+    EXPECT_LT(fs::file_size(path), fixedText.size());
+
+    auto [status, count, loaded] = FloatDataSet::loadText(path);
+    ASSERT_EQ(status, geo::geoStatus::SUCCESS);
+    ASSERT_EQ(count, static_cast<size_t>(n));
+    for (int i = 0; i < n; i++)
+    {
+      if (std::isnan(data[i]))
+      {
+        EXPECT_TRUE(std::isnan(loaded[i]));
+      }
+      else if (textFormat == geo::TextFormat::SHORTEST || data[i] == std::trunc(data[i]))
+      {
+        EXPECT_EQ(loaded[i], data[i]) << i;
+      }
+    }
+    free(loaded);
+  }
+}
+
+// Parallel text saving writes the same bytes as serial saving
+TEST(DataSetTest, SavingTextParallel)
+{
+  // Use "data/" folder
+  fs::path currentPath(fs::current_path() / "data");
+  fs::create_directories(currentPath);
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  int n = 1000000;
+  int lineSize = 1000;
+  float *data = createSequentialData(n);
+  ASSERT_NE(data, nullptr);
+
+  auto readFile = [](const string &path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    return string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  };
+
+  for (bool reverse : {false, true})
+  {
+    const string serialPath = (currentPath / "serial.txt").string();
+    const string parallelPath = (currentPath / "parallel_save.txt").string();
+
+    auto save = [&](const string &path)
+    {
+      // Header written through the file pointer before the data
+      FILE *fp = fopen(path.c_str(), "wb");
+      fprintf(fp, "header\n");
+      geo::geoStatus status = reverse
+                                  ? FloatDataSet::saveTextReverseBatches(fp, 0, data, n, lineSize)
+                                  : FloatDataSet::saveText(fp, 0, data, n, lineSize);
+      fprintf(fp, "footer\n");
+      fclose(fp);
+      return status;
+    };
+
+    geo::setThreads(1);
+    ASSERT_EQ(save(serialPath), geo::geoStatus::SUCCESS);
+    geo::setThreads(4);
+    ASSERT_EQ(save(parallelPath), geo::geoStatus::SUCCESS);
+    geo::setThreads(0);
+
+    string serialText = readFile(serialPath);
+    EXPECT_EQ(serialText.substr(0, 7), "header\n");
+    EXPECT_EQ(serialText.substr(serialText.size() - 7), "footer\n");
+    EXPECT_EQ(readFile(parallelPath), serialText);
+  }
+
+  free(data);
+}
+
 float * createSequentialData(int n) {
   float * data = (float*)malloc(n * sizeof(float));
 
@@ -5,6 +5,9 @@
  * @copyright MIT License
  */
 
+#include <atomic>
+#include <bitset>
+#include <fstream>
 #include <iostream>
 #include <filesystem>
 #include <gtest/gtest.h>
@@ -18,6 +21,8 @@ using std::endl;
 
 using geo::Grid;
 using geo::GridFormat;
+using geo::CompareMode;
+using geo::ResampleMethod;
 using geo::geoStatus;
 
 /**
@@ -432,6 +437,2158 @@ TEST(GridTest, LoadSurferDouble)
   EXPECT_EQ(isSequentialGrid(grid), true);
 }
 
+// Load Esri Float mapped into memory
+TEST(GridTest, LoadEsriFloatMapped)
+{
+  Grid grid;
+  geo::geoStatus status;
+
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const string path = (currentPath / "esriFloatMapped.bil").string();
+
+  // Save ESRI Float grid
+  ASSERT_EQ(geo::Esri::saveFloat(createTestGrid(), path), geo::geoStatus::SUCCESS);
+
+  // Map ESRI Float grid
+  status = geo::Esri::loadFloat(grid, path, true);
+
+  // Status must be true, grid mapped successfully.
+  EXPECT_EQ(status, geo::geoStatus::SUCCESS);
+  EXPECT_TRUE(grid.isMapped());
+  EXPECT_EQ(grid.rowOrder(), geo::RowOrder::TOP_DOWN);
+
+  // Check if grid is sequential
+  EXPECT_EQ(isSequentialGrid(grid), true);
+
+  // Changes are private to the mapping
+  grid(0, 0) = -1.0f;
+  EXPECT_EQ(grid(0, 0), -1.0f);
+
+  Grid other;
+  ASSERT_EQ(geo::LoadGrid(other, path, true), geo::geoStatus::SUCCESS);
+  EXPECT_EQ(isSequentialGrid(other), true);
+
+  // Saving a mapped grid keeps the row order
+  grid(0, 0) = 0.0f;
+  const string copyPath = (currentPath / "esriFloatMappedCopy.bil").string();
+  ASSERT_EQ(geo::Esri::saveFloat(grid, copyPath), geo::geoStatus::SUCCESS);
+
+  Grid copy;
+  ASSERT_EQ(geo::Esri::loadFloat(copy, copyPath), geo::geoStatus::SUCCESS);
+  EXPECT_FALSE(copy.isMapped());
+  EXPECT_EQ(isSequentialGrid(copy), true);
+
+  // Copies are allocated in memory
+  Grid copied(grid);
+  EXPECT_FALSE(copied.isMapped());
+  EXPECT_EQ(isSequentialGrid(copied), true);
+}
+
+// Load Envi Float mapped into memory
+TEST(GridTest, LoadEnviFloatMapped)
+{
+  Grid grid;
+
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const string path = (currentPath / "enviFloatMapped.flt").string();
+
+  // Save ENVI float grid
+  ASSERT_EQ(geo::Envi::saveFloat(createTestGrid(), path), geo::geoStatus::SUCCESS);
+
+  // Map ENVI float grid
+  EXPECT_EQ(geo::Envi::loadBinary(grid, path, true), geo::geoStatus::SUCCESS);
+  EXPECT_TRUE(grid.isMapped());
+
+  // Check if grid is sequential
+  EXPECT_EQ(isSequentialGrid(grid), true);
+
+  // Mapping is moved with the grid
+  Grid moved(std::move(grid));
+  EXPECT_TRUE(moved.isMapped());
+  EXPECT_FALSE(grid.isMapped());
+  EXPECT_EQ(isSequentialGrid(moved), true);
+
+  // Surfer stores first row first
+  const string surferPath = (currentPath / "surferFromMapped.grd").string();
+  ASSERT_EQ(geo::Surfer::save(moved, surferPath), geo::geoStatus::SUCCESS);
+
+  Grid surfer;
+  ASSERT_EQ(geo::Surfer::load(surfer, surferPath), geo::geoStatus::SUCCESS);
+  EXPECT_EQ(isSequentialGrid(surfer), true);
+}
+
+// Read windows from binary grids without loading them
+TEST(GridTest, ReadWindowBinary)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  Grid grid = createTestGrid();
+  auto [rows, columns] = grid.dimensions();
+
+  const vector<std::pair<string, GridFormat>> files{
+      {"readerEsri.bil", GridFormat::ESRI_FLOAT},
+      {"readerEnviFloat.flt", GridFormat::ENVI_FLOAT},
+      {"readerEnviDouble.flt", GridFormat::ENVI_DOUBLE},
+      {"readerSurfer6.grd", GridFormat::SURFER_FLOAT},
+      {"readerSurfer7.grd", GridFormat::SURFER_DOUBLE},
+      {"readerTiled.geo", GridFormat::GEO_TILED}};
+
+  for (const auto &[name, format] : files)
+  {
+    const string path = (currentPath / name).string();
+    ASSERT_EQ(geo::SaveGrid(grid, path, format), geoStatus::SUCCESS);
+
+    geo::GridReader reader(path, format);
+    ASSERT_TRUE(reader.isOpen()) << name;
+    EXPECT_EQ(reader.gridFormat(), format);
+    EXPECT_EQ(reader.dimensions(), grid.dimensions());
+
+    // Partial window
+    vector<float> window(40 * 30);
+    ASSERT_EQ(reader.readWindow(300, 17, 40, 30, window.data()), geoStatus::SUCCESS) << name;
+    for (int i = 0; i < 40; i++)
+    {
+      for (int j = 0; j < 30; j++)
+      {
+        EXPECT_EQ(window[i * 30 + j], (300 + i) * columns + 17 + j) << name;
+      }
+    }
+
+    // Complete rows
+    vector<float> block(3 * columns);
+    ASSERT_EQ(reader.readRows(rows - 3, 3, block.data()), geoStatus::SUCCESS) << name;
+    EXPECT_EQ(block[0], (rows - 3) * columns);
+    EXPECT_EQ(block[3 * columns - 1], rows * columns - 1);
+
+    // Windows outside the grid are rejected
+    EXPECT_EQ(reader.readRows(rows - 2, 3, block.data()), geoStatus::FAILURE);
+  }
+}
+
+// Read windows from text grids without loading them
+TEST(GridTest, ReadWindowText)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  Grid grid = createTestGrid();
+  auto [rows, columns] = grid.dimensions();
+  auto [x0, y0, xMax, yMax] = grid.extents();
+  auto [dxDeg, dyDeg] = grid.resolutionDegrees();
+
+  const string esriPath = (currentPath / "readerEsri.asc").string();
+  const string surferPath = (currentPath / "readerSurfer.grd").string();
+  const string textPath = (currentPath / "readerText.txt").string();
+  ASSERT_EQ(geo::SaveGrid(grid, esriPath, GridFormat::ESRI_ASCII), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::SaveGrid(grid, surferPath, GridFormat::SURFER_ASCII), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::SaveGrid(grid, textPath, GridFormat::TEXT_REVERSE), geoStatus::SUCCESS);
+
+  geo::GridReader esri(esriPath);
+  geo::GridReader surfer(surferPath, GridFormat::SURFER_ASCII);
+  geo::GridReader text;
+  ASSERT_EQ(text.openText(textPath, rows, columns, x0, y0, dxDeg, dyDeg, NAN, true), geoStatus::SUCCESS);
+
+  for (geo::GridReader *reader : {&esri, &surfer, &text})
+  {
+    ASSERT_TRUE(reader->isOpen());
+    EXPECT_EQ(reader->dimensions(), grid.dimensions());
+
+    // Windows far from the start, then back, then forward again to use checkpoints
+    for (int row : {400, 10, 260})
+    {
+      Grid window;
+      ASSERT_EQ(reader->readWindow(row, 5, 20, 12, window), geoStatus::SUCCESS);
+      EXPECT_EQ(window.dimensions(), std::make_tuple(20, 12));
+
+      // Window is georeferenced from the header values
+      auto [rx0, ry0, rxMax, ryMax] = reader->extents();
+      auto [rdxDeg, rdyDeg] = reader->resolutionDegrees();
+      auto [wx0, wy0, wxMax, wyMax] = window.extents();
+      EXPECT_DOUBLE_EQ(wx0, rx0 + 5 * rdxDeg);
+      EXPECT_DOUBLE_EQ(wy0, ry0 + row * rdyDeg);
+
+      for (int i = 0; i < 20; i++)
+      {
+        for (int j = 0; j < 12; j++)
+        {
+          EXPECT_EQ(window(i, j), (row + i) * columns + 5 + j);
+        }
+      }
+    }
+  }
+}
+
+// Grids loaded from ESRI/ENVI files keep the file row order
+TEST(GridTest, RowOrder)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const string esriPath = (currentPath / "rowOrder.bil").string();
+  const string enviPath = (currentPath / "rowOrder.flt").string();
+
+  ASSERT_EQ(geo::Esri::saveFloat(createTestGrid(), esriPath), geoStatus::SUCCESS);
+
+  // ESRI binary stores the last row first, rows are not reversed on load
+  Grid esri;
+  ASSERT_EQ(geo::Esri::loadFloat(esri, esriPath), geoStatus::SUCCESS);
+  EXPECT_EQ(esri.rowOrder(), geo::RowOrder::TOP_DOWN);
+  EXPECT_EQ(isSequentialGrid(esri), true);
+  auto [rows, columns] = esri.dimensions();
+  EXPECT_EQ(esri.c_float()[0], (rows - 1) * columns);
+  EXPECT_EQ(esri.row(0)[0], 0.0f);
+
+  // ENVI has the same row order, data is written as stored
+  ASSERT_EQ(geo::Envi::saveFloat(esri, enviPath), geoStatus::SUCCESS);
+  Grid envi;
+  ASSERT_EQ(geo::Envi::loadBinary(envi, enviPath), geoStatus::SUCCESS);
+  EXPECT_EQ(envi.rowOrder(), geo::RowOrder::TOP_DOWN);
+  EXPECT_EQ(isSequentialGrid(envi), true);
+
+  // Mosaics keep the order of the first grid
+  Grid bottomUp = createTestGrid();
+  Grid mosaic;
+  ASSERT_TRUE(geo::mosaicTop(envi, bottomUp, mosaic));
+  EXPECT_EQ(mosaic.rowOrder(), geo::RowOrder::TOP_DOWN);
+  EXPECT_EQ(mosaic.dimensions(), std::make_tuple(2 * rows, columns));
+  EXPECT_EQ(mosaic(rows - 1, columns - 1), rows * columns - 1);
+  EXPECT_EQ(mosaic(rows, 0), 0.0f);
+  EXPECT_EQ(mosaic(2 * rows - 1, columns - 1), rows * columns - 1);
+
+  ASSERT_TRUE(geo::mosaicRight(bottomUp, envi, mosaic));
+  EXPECT_EQ(mosaic.rowOrder(), geo::RowOrder::BOTTOM_UP);
+  EXPECT_EQ(mosaic(1, columns), columns);
+
+  // Reordering moves data, values are kept
+  envi.reorder(geo::RowOrder::BOTTOM_UP);
+  EXPECT_EQ(envi.rowOrder(), geo::RowOrder::BOTTOM_UP);
+  EXPECT_EQ(envi.c_float()[0], 0.0f);
+  EXPECT_EQ(isSequentialGrid(envi), true);
+}
+
+// Grids with more than 2^31 cells: sparse ESRI float fixture, about 8 GB.
+// Opt-in, runs only when GEO_LARGE_TESTS is set.
+TEST(GridTest, LargeGrid)
+{
+  if (std::getenv("GEO_LARGE_TESTS") == nullptr)
+  {
+    GTEST_SKIP() << "Set GEO_LARGE_TESTS to run the 8 GB grid test";
+  }
+
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  // 46341 * 46341 > 2^31 cells
+  const int rows = 46341;
+  const int columns = 46341;
+  const size_t cells = geo::cellCount(rows, columns);
+  ASSERT_GT(cells, static_cast<size_t>(std::numeric_limits<int>::max()));
+
+  // Filesystems without sparse files allocate the whole file
+  std::error_code error;
+  fs::space_info space = fs::space(currentPath, error);
+  if (error || space.available < cells * sizeof(float))
+  {
+    GTEST_SKIP() << "Not enough free space for a " << cells * sizeof(float) << " bytes file";
+  }
+
+  const string path = (currentPath / "large.bil").string();
+  const string headerPath = (currentPath / "large.hdr").string();
+
+  // Header of a 1 arc second grid
+  FILE *fp = fopen(headerPath.c_str(), "w");
+  ASSERT_NE(fp, nullptr);
+  fprintf(fp, "nrows %d\nncols %d\nnbands 1\nnbits 32\npixeltype float\nbyteorder i\nlayout bil\n", rows, columns);
+  fprintf(fp, "ulxmap -80.0\nulymap 10.0\nxdim 0.000277777777778\nydim 0.000277777777778\nnodata -9999\n");
+  fclose(fp);
+
+  // Sparse data file: zeroes, except for three cells
+  {
+    std::ofstream data(path, std::ios::binary);
+  }
+  fs::resize_file(path, cells * sizeof(float), error);
+  if (error)
+  {
+    fs::remove(path);
+    fs::remove(headerPath);
+    GTEST_SKIP() << "Unable to create a sparse " << cells * sizeof(float) << " bytes file";
+  }
+
+  // Last row is the first on the file
+  auto writeCell = [&](int row, int column, float value)
+  {
+    std::fstream data(path, std::ios::binary | std::ios::in | std::ios::out);
+    data.seekp(static_cast<std::streamoff>(geo::linear2D(rows - 1 - row, column, columns) * sizeof(float)));
+    data.write(reinterpret_cast<const char *>(&value), sizeof(float));
+  };
+  writeCell(rows - 1, columns - 1, 1.0f);
+  writeCell(0, 0, 2.0f);
+  writeCell(0, columns - 1, 3.0f);
+
+  // Windowed reads
+  geo::GridReader reader(path);
+  ASSERT_TRUE(reader.isOpen());
+  float corner[2];
+  ASSERT_EQ(reader.readWindow(0, columns - 2, 1, 2, corner), geoStatus::SUCCESS);
+  EXPECT_EQ(corner[0], 0.0f);
+  EXPECT_EQ(corner[1], 3.0f);
+
+  // Mapped load, cells past 2^31 are addressed correctly
+  Grid grid;
+  if (geo::Esri::loadFloat(grid, path, true) == geoStatus::SUCCESS)
+  {
+    EXPECT_EQ(grid.dimensions(), std::make_tuple(rows, columns));
+    EXPECT_EQ(grid(rows - 1, columns - 1), 1.0f);
+    EXPECT_EQ(grid(0, 0), 2.0f);
+    EXPECT_EQ(grid(0, columns - 1), 3.0f);
+    EXPECT_EQ(grid.row(0)[columns - 1], 3.0f);
+    EXPECT_EQ(grid.c_float()[cells - 1], 3.0f);
+    EXPECT_EQ(grid(rows / 2, columns / 2), 0.0f);
+  }
+  else
+  {
+    cout << "Unable to map " << path << ", skipping mapped checks" << endl;
+  }
+  grid.dispose();
+
+  fs::remove(path);
+  fs::remove(headerPath);
+}
+
+// Typed grids keep the cell type of the file
+TEST(GridTest, TypedGrid)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  // Elevations in meters, -9999 as NODATA
+  Grid grid = createTestGrid();
+  auto [rows, columns] = grid.dimensions();
+  grid.setNoData(-9999.0f);
+  grid(1, 2) = -9999.0f;
+
+  geo::BasicGrid<int16_t> elevations = grid.convert<int16_t>();
+  ASSERT_EQ(elevations.dimensions(), grid.dimensions());
+  EXPECT_EQ(elevations.cellType(), geo::CellType::I16);
+  EXPECT_EQ(elevations.noDataValue(), -9999.0);
+  EXPECT_EQ(elevations(1, 2), -9999);
+  // Values are clamped to the int16 range
+  EXPECT_EQ(elevations(rows - 1, columns - 1), std::numeric_limits<int16_t>::max());
+  EXPECT_EQ(elevations(0, 100), 100);
+
+  // ESRI binary: nbits 16, pixeltype signedint
+  const string esriPath = (currentPath / "typedEsri.bil").string();
+  ASSERT_EQ(geo::SaveGrid(elevations, esriPath, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  EXPECT_EQ(fs::file_size(esriPath), geo::cellCount(rows, columns) * sizeof(int16_t));
+
+  geo::BasicGrid<int16_t> esri;
+  ASSERT_EQ(geo::LoadGrid(esri, esriPath), geoStatus::SUCCESS);
+  EXPECT_EQ(esri(1, 2), -9999);
+  EXPECT_EQ(esri(0, 100), 100);
+  EXPECT_EQ(esri.noDataValue(), -9999.0);
+  EXPECT_EQ(memcmp(esri.row(0), elevations.row(0), columns * sizeof(int16_t)), 0);
+
+  // Typed loads do not convert
+  geo::BasicGrid<int32_t> wrongType;
+  EXPECT_EQ(geo::Esri::loadBinary(wrongType, esriPath), geoStatus::FAILURE);
+
+  // Float grids convert on load
+  Grid converted;
+  ASSERT_EQ(geo::LoadGrid(converted, esriPath), geoStatus::SUCCESS);
+  EXPECT_EQ(converted(0, 100), 100.0f);
+  EXPECT_EQ(converted(1, 2), -9999.0f);
+
+  // ENVI: data type 1 (8-bit unsigned)
+  geo::BasicGrid<uint8_t> bytes = grid.convert<uint8_t>(0);
+  const string enviPath = (currentPath / "typedEnvi.flt").string();
+  ASSERT_EQ(geo::SaveGrid(bytes, enviPath, GridFormat::ENVI_FLOAT), geoStatus::SUCCESS);
+  EXPECT_EQ(fs::file_size(enviPath), geo::cellCount(rows, columns));
+
+  geo::BasicGrid<uint8_t> envi;
+  ASSERT_EQ(geo::Envi::loadBinary(envi, enviPath, true), geoStatus::SUCCESS);
+  EXPECT_TRUE(envi.isMapped());
+  EXPECT_EQ(envi(1, 2), 0);
+  EXPECT_EQ(envi(0, 200), 200);
+  EXPECT_EQ(envi(0, 300), 255);
+
+  // ENVI double keeps double precision
+  geo::BasicGrid<double> precise = grid.convert<double>();
+  precise(0, 1) = 0.1;
+  const string doublePath = (currentPath / "typedEnviDouble.flt").string();
+  ASSERT_EQ(geo::SaveGrid(precise, doublePath, GridFormat::ENVI_DOUBLE), geoStatus::SUCCESS);
+  EXPECT_EQ(fs::file_size(doublePath), geo::cellCount(rows, columns) * sizeof(double));
+
+  geo::BasicGrid<double> loaded;
+  ASSERT_EQ(geo::LoadGrid(loaded, doublePath), geoStatus::SUCCESS);
+  EXPECT_EQ(loaded.gridFormat(), GridFormat::ENVI_DOUBLE);
+  EXPECT_EQ(loaded(0, 1), 0.1);
+  EXPECT_EQ(loaded(rows - 1, columns - 1), rows * columns - 1);
+
+  // Surfer 7 double into a double grid
+  const string surferPath = (currentPath / "typedSurfer7.grd").string();
+  ASSERT_EQ(geo::SaveGrid(grid, surferPath, GridFormat::SURFER_DOUBLE), geoStatus::SUCCESS);
+  geo::BasicGrid<double> surfer;
+  ASSERT_EQ(geo::Surfer::load(surfer, surferPath), geoStatus::SUCCESS);
+  EXPECT_EQ(surfer(0, 100), 100.0);
+  EXPECT_EQ(surfer(1, 2), -9999.0);
+}
+
+// Tiled layout keeps cells and georeferencing
+TEST(GridTest, TiledGrid)
+{
+  Grid grid = createTestGrid();
+  auto [rows, columns] = grid.dimensions();
+
+  // Tile size is rounded up to a power of two, edge tiles are partial
+  geo::TiledGrid tiled(grid, 100);
+  EXPECT_EQ(tiled.tileSide(), 128);
+  EXPECT_EQ(tiled.tileDimensions(), std::make_tuple(4, 4));
+  EXPECT_EQ(tiled.dimensions(), grid.dimensions());
+  EXPECT_EQ(tiled.extents(), grid.extents());
+
+  for (int i = 0; i < rows; i += 7)
+  {
+    for (int j = 0; j < columns; j += 3)
+    {
+      ASSERT_EQ(tiled(i, j), grid(i, j));
+    }
+  }
+
+  // Edge tile
+  auto edge = tiled.tile(3, 3);
+  EXPECT_EQ(edge.row, 384);
+  EXPECT_EQ(edge.height, rows - 384);
+  EXPECT_EQ(edge.width, columns - 384);
+  EXPECT_EQ(edge(edge.height - 1, edge.width - 1), rows * columns - 1);
+
+  // Every cell is visited once
+  geo::setThreads(4);
+  std::atomic<size_t> visited{0};
+  tiled.forEachTile([&](const geo::TiledGrid::Tile &tile)
+                    { visited += static_cast<size_t>(tile.height) * tile.width; });
+  EXPECT_EQ(visited, geo::cellCount(rows, columns));
+
+  // Only the tiles touched by a window
+  std::atomic<int> touched{0};
+  tiled.forEachTile(10, 120, 50, 20, [&](const geo::TiledGrid::Tile &)
+                    { touched++; });
+  EXPECT_EQ(touched, 2);
+
+  // Tile-level updates, then back to a row-major grid
+  tiled.forEachTile([](const geo::TiledGrid::Tile &tile)
+                    {
+                      for (int i = 0; i < tile.height; i++)
+                      {
+                        for (int j = 0; j < tile.width; j++)
+                        {
+                          tile(i, j) += 1.0f;
+                        }
+                      } });
+  geo::setThreads(0);
+
+  Grid result = tiled.toGrid(GridFormat::ESRI_FLOAT);
+  ASSERT_EQ(result.dimensions(), grid.dimensions());
+  EXPECT_EQ(result.extents(), grid.extents());
+  EXPECT_EQ(result(0, 0), 1.0f);
+  EXPECT_EQ(result(rows - 1, columns - 1), rows * columns);
+
+  // Copies own their tiles
+  geo::TiledGrid copy = tiled;
+  copy(0, 0) = -1.0f;
+  EXPECT_EQ(tiled(0, 0), 1.0f);
+}
+
+// Native tiled format: round trip, tile value ranges and overviews
+TEST(GridTest, GeoTiledGrid)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  Grid grid = createTestGrid();
+  auto [rows, columns] = grid.dimensions();
+  grid.setNoData(-9999.0f);
+
+  // First 64 x 64 tile is NODATA
+  for (int i = 0; i < 64; i++)
+  {
+    for (int j = 0; j < 64; j++)
+    {
+      grid(i, j) = -9999.0f;
+    }
+  }
+
+  const string path = (currentPath / "tiled.geo").string();
+  ASSERT_EQ(geo::GeoTiled::save(grid, path, 64), geoStatus::SUCCESS);
+
+  Grid loaded;
+  ASSERT_EQ(geo::LoadGrid(loaded, path), geoStatus::SUCCESS);
+  EXPECT_EQ(loaded.gridFormat(), GridFormat::GEO_TILED);
+  ASSERT_EQ(loaded.dimensions(), grid.dimensions());
+  EXPECT_EQ(loaded.extents(), grid.extents());
+  EXPECT_EQ(loaded.noDataValue(), -9999.0);
+  for (int i = 0; i < rows; i++)
+  {
+    ASSERT_EQ(memcmp(loaded.row(i), grid.row(i), columns * sizeof(float)), 0) << i;
+  }
+
+  // Header and tile tables
+  int fd = geo::openFile(path);
+  geo::GeoTiled::Index index;
+  ASSERT_EQ(geo::GeoTiled::readIndex(fd, index), geoStatus::SUCCESS);
+  EXPECT_EQ(index.cellType, geo::CellType::F32);
+  EXPECT_EQ(index.tileSize, 64);
+
+  // Overviews until a level fits in one tile
+  ASSERT_GT(index.levels.size(), 1u);
+  EXPECT_EQ(index.levels[1].rows, (rows + 1) / 2);
+  EXPECT_EQ(index.levels[1].columns, (columns + 1) / 2);
+  EXPECT_EQ(index.levels[1].dxDeg, 2.0 * index.dxDeg);
+  EXPECT_EQ(index.levels.back().tileRows, 1);
+  EXPECT_EQ(index.levels.back().tileColumns, 1);
+
+  // Per-tile ranges ignore NODATA
+  const auto &tiles = index.levels[0].tiles;
+  EXPECT_TRUE(std::isnan(tiles[0].min));
+  EXPECT_EQ(tiles[1].min, 64.0);
+  EXPECT_EQ(tiles[1].max, 63.0 * columns + 127.0);
+  EXPECT_EQ(index.range(), std::make_tuple(64.0, rows * columns - 1.0));
+
+  // Overview cells average the valid cells of 2 x 2 blocks
+  vector<float> overview(2 * 2);
+  ASSERT_EQ(geo::GeoTiled::readWindow(fd, index, 1, 40, 40, 2, 2, overview.data()), geoStatus::SUCCESS);
+  EXPECT_EQ(overview[0], (80.0f * columns + 80.0f + 81.0f * columns + 81.0f) / 2.0f);
+  ASSERT_EQ(geo::GeoTiled::readWindow(fd, index, 1, 0, 0, 2, 2, overview.data()), geoStatus::SUCCESS);
+  EXPECT_EQ(overview[3], -9999.0f);
+  geo::closeFile(fd);
+
+  // Typed grids keep their cell type
+  geo::BasicGrid<int16_t> elevations = grid.convert<int16_t>();
+  const string typedPath = (currentPath / "tiledTyped.geo").string();
+  ASSERT_EQ(geo::SaveGrid(elevations, typedPath, GridFormat::GEO_TILED), geoStatus::SUCCESS);
+
+  geo::BasicGrid<int16_t> typed;
+  ASSERT_EQ(geo::LoadGrid(typed, typedPath), geoStatus::SUCCESS);
+  EXPECT_EQ(typed(0, 0), -9999);
+  EXPECT_EQ(typed(100, 100), elevations(100, 100));
+
+  geo::BasicGrid<int32_t> wrongType;
+  EXPECT_EQ(geo::GeoTiled::load(wrongType, typedPath), geoStatus::FAILURE);
+
+  // Windows convert to float
+  geo::GridReader reader(typedPath);
+  ASSERT_TRUE(reader.isOpen());
+  vector<float> window(10 * 10);
+  ASSERT_EQ(reader.readWindow(50, 60, 10, 10, window.data()), geoStatus::SUCCESS);
+  EXPECT_EQ(window[0], -9999.0f);
+  EXPECT_EQ(window[99], 59.0f * columns + 69.0f);
+
+  // Uncompressed tiles
+  const string rawPath = (currentPath / "tiledRaw.geo").string();
+  ASSERT_EQ(geo::GeoTiled::save(grid, rawPath, 64, 0, geo::GeoTiled::Codec::RAW), geoStatus::SUCCESS);
+  Grid raw;
+  ASSERT_EQ(geo::LoadGrid(raw, rawPath), geoStatus::SUCCESS);
+  EXPECT_EQ(memcmp(raw.c_data(), loaded.c_data(), geo::cellCount(rows, columns) * sizeof(float)), 0);
+
+  // Tiles are stored in tile order, the file does not depend on the count of threads
+  auto readFile = [](const string &file)
+  {
+    std::ifstream in(file, std::ios::binary);
+    return string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  };
+  const string serialPath = (currentPath / "tiledSerial.geo").string();
+  const string parallelPath = (currentPath / "tiledParallel.geo").string();
+  geo::setThreads(1);
+  ASSERT_EQ(geo::GeoTiled::save(grid, serialPath, 16), geoStatus::SUCCESS);
+  geo::setThreads(8);
+  ASSERT_EQ(geo::GeoTiled::save(grid, parallelPath, 16), geoStatus::SUCCESS);
+  geo::setThreads(0);
+  EXPECT_EQ(readFile(serialPath), readFile(parallelPath));
+
+  fd = geo::openFile(parallelPath);
+  ASSERT_EQ(geo::GeoTiled::readIndex(fd, index), geoStatus::SUCCESS);
+  geo::closeFile(fd);
+  for (size_t i = 1; i < index.levels[0].tiles.size(); i++)
+  {
+    ASSERT_EQ(index.levels[0].tiles[i].offset, index.levels[0].tiles[i - 1].offset + index.levels[0].tiles[i - 1].length) << i;
+  }
+
+  // Level tables that do not match their dimensions are rejected
+  const string corruptPath = (currentPath / "tiledCorrupt.geo").string();
+  auto corrupt = [&](size_t position, int32_t value)
+  {
+    fs::copy_file(parallelPath, corruptPath, fs::copy_options::overwrite_existing);
+    std::fstream file(corruptPath, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(position);
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    file.close();
+
+    int corruptFd = geo::openFile(corruptPath);
+    geo::GeoTiled::Index corruptIndex;
+    geoStatus status = geo::GeoTiled::readIndex(corruptFd, corruptIndex);
+    geo::closeFile(corruptFd);
+    return status;
+  };
+  const size_t level0 = geo::GeoTiled::headerSize;
+  const size_t level1 = level0 + geo::GeoTiled::levelEntrySize;
+  EXPECT_EQ(corrupt(level0 + 8, -1), geoStatus::FAILURE);
+  EXPECT_EQ(corrupt(level0 + 12, 1), geoStatus::FAILURE);
+  EXPECT_EQ(corrupt(level0, rows - 1), geoStatus::FAILURE);
+  EXPECT_EQ(corrupt(level1 + 8, index.levels[1].tileRows - 1), geoStatus::FAILURE);
+  EXPECT_EQ(corrupt(28, 8), geoStatus::FAILURE);
+  EXPECT_EQ(corrupt(level0 + 8, index.levels[0].tileRows), geoStatus::SUCCESS);
+
+  // Tables and tiles outside the file, tiles longer than their cells
+  uint64_t tableOffset = 0;
+  {
+    std::ifstream file(parallelPath, std::ios::binary);
+    file.seekg(level0 + 32);
+    file.read(reinterpret_cast<char *>(&tableOffset), sizeof(tableOffset));
+  }
+  EXPECT_EQ(corrupt(level0 + 36, 1), geoStatus::FAILURE);
+  EXPECT_EQ(corrupt(tableOffset + 12, 1), geoStatus::FAILURE);
+  EXPECT_EQ(corrupt(tableOffset + 4, 1), geoStatus::FAILURE);
+  const int32_t longTile = static_cast<int32_t>(geo::GeoTiled::maxTileLength(index) + 1);
+  EXPECT_EQ(corrupt(tableOffset + 8, longTile), geoStatus::FAILURE);
+}
+
+// Bounded error tiles, checked with Grid::same
+TEST(GridTest, GeoTiledLossy)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  // Smooth surface with noise, NODATA and NaN cells
+  Grid grid = createTestGrid();
+  auto [rows, columns] = grid.dimensions();
+  grid.setNoData(-9999.0f);
+  uint32_t state = 1;
+  for (int i = 0; i < rows; i++)
+  {
+    for (int j = 0; j < columns; j++)
+    {
+      state = state * 1103515245u + 12345u;
+      grid(i, j) = 1500.0f + 40.0f * std::sin(i * 0.02f) + 25.0f * std::cos(j * 0.03f) + (state >> 16) / 65536.0f * 0.05f;
+    }
+  }
+  grid(10, 10) = -9999.0f;
+  grid(10, 11) = NAN;
+  grid(0, 0) = -9999.0f;
+
+  const double maxError = 0.01;
+  const string lossyPath = (currentPath / "tiledLossy.geo").string();
+  const string losslessPath = (currentPath / "tiledLossless.geo").string();
+  ASSERT_EQ(geo::GeoTiled::save(grid, lossyPath, 256, 0, geo::GeoTiled::Codec::LOSSY, maxError), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::GeoTiled::save(grid, losslessPath, 256, 0), geoStatus::SUCCESS);
+  EXPECT_LT(fs::file_size(lossyPath) * 2, fs::file_size(losslessPath));
+
+  Grid loaded;
+  ASSERT_EQ(geo::LoadGrid(loaded, lossyPath), geoStatus::SUCCESS);
+  ASSERT_EQ(loaded.dimensions(), grid.dimensions());
+  for (int i = 0; i < rows; i++)
+  {
+    for (int j = 0; j < columns; j++)
+    {
+      ASSERT_TRUE(grid.same(loaded, i, j, maxError)) << i << " " << j << " " << grid(i, j) << " " << loaded(i, j);
+    }
+  }
+  EXPECT_EQ(loaded(10, 10), -9999.0f);
+  EXPECT_TRUE(std::isnan(loaded(10, 11)));
+  EXPECT_EQ(loaded(0, 0), -9999.0f);
+
+  // Tile ranges are the ranges of the decoded cells
+  int fd = geo::openFile(lossyPath);
+  geo::GeoTiled::Index index;
+  ASSERT_EQ(geo::GeoTiled::readIndex(fd, index), geoStatus::SUCCESS);
+  geo::closeFile(fd);
+  EXPECT_EQ(index.codec, geo::GeoTiled::Codec::LOSSY);
+  EXPECT_EQ(index.maxError, maxError);
+  double min = NAN;
+  double max = NAN;
+  for (int i = 0; i < rows; i++)
+  {
+    for (int j = 0; j < columns; j++)
+    {
+      if (loaded(i, j) != -9999.0f)
+      {
+        min = std::fmin(min, loaded(i, j));
+        max = std::fmax(max, loaded(i, j));
+      }
+    }
+  }
+  EXPECT_EQ(index.range(), std::make_tuple(min, max));
+
+  // Integer grids are not quantized
+  geo::BasicGrid<int16_t> elevations = grid.convert<int16_t>();
+  EXPECT_EQ(geo::GeoTiled::save(elevations, lossyPath, 256, 0, geo::GeoTiled::Codec::LOSSY, 1.0), geoStatus::FAILURE);
+}
+
+// Lossless codec round trips
+TEST(GridTest, Compression)
+{
+  using geo::Compression;
+
+  // Smooth elevations compress, decoding restores every bit
+  const int rows = 200;
+  const int columns = 300;
+  vector<float> elevations(rows * columns);
+  for (int i = 0; i < rows; i++)
+  {
+    for (int j = 0; j < columns; j++)
+    {
+      elevations[i * columns + j] = 1500.0f + 0.25f * i + 0.125f * j;
+    }
+  }
+  elevations[5] = NAN;
+  elevations[6] = -0.0f;
+
+  vector<char> encoded;
+  Compression::encode(elevations.data(), rows, columns, encoded);
+  EXPECT_LT(encoded.size(), elevations.size() * sizeof(float) / 2);
+
+  vector<float> decoded(rows * columns);
+  ASSERT_EQ(Compression::decode(encoded.data(), encoded.size(), rows, columns, decoded.data()), geoStatus::SUCCESS);
+  EXPECT_EQ(memcmp(decoded.data(), elevations.data(), elevations.size() * sizeof(float)), 0);
+
+  // Truncated data is rejected
+  EXPECT_EQ(Compression::decode(encoded.data(), encoded.size() / 2, rows, columns, decoded.data()), geoStatus::FAILURE);
+
+  // Integer deltas, including negative steps and wrap around
+  vector<int16_t> values{0, -1, 1, -32768, 32767, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5};
+  encoded.clear();
+  Compression::encode(values.data(), 4, 5, encoded);
+  vector<int16_t> restored(values.size());
+  ASSERT_EQ(Compression::decode(encoded.data(), encoded.size(), 4, 5, restored.data()), geoStatus::SUCCESS);
+  EXPECT_EQ(restored, values);
+
+  // Incompressible blocks are stored
+  vector<uint32_t> noise(4096);
+  uint32_t state = 12345;
+  for (auto &n : noise)
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    n = state;
+  }
+  encoded.clear();
+  Compression::encode(noise.data(), 64, 64, encoded);
+  EXPECT_EQ(encoded.size(), noise.size() * sizeof(uint32_t) + 1);
+  vector<uint32_t> noiseRestored(noise.size());
+  ASSERT_EQ(Compression::decode(encoded.data(), encoded.size(), 64, 64, noiseRestored.data()), geoStatus::SUCCESS);
+  EXPECT_EQ(noiseRestored, noise);
+}
+
+// Pipelined conversion, blocks of rows from GridReader to GridWriter
+TEST(GridTest, ConvertGrid)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  Grid grid = createTestGrid();
+  auto [rows, columns] = grid.dimensions();
+
+  const string inputPath = (currentPath / "convertInput.asc").string();
+  ASSERT_EQ(geo::SaveGrid(grid, inputPath, GridFormat::ESRI_ASCII), geoStatus::SUCCESS);
+
+  const vector<std::pair<string, GridFormat>> files{
+      {"convertEsri.bil", GridFormat::ESRI_FLOAT},
+      {"convertEnviFloat.flt", GridFormat::ENVI_FLOAT},
+      {"convertEnviDouble.flt", GridFormat::ENVI_DOUBLE},
+      {"convertSurfer6.grd", GridFormat::SURFER_FLOAT},
+      {"convertSurfer7.grd", GridFormat::SURFER_DOUBLE},
+      {"convertText.txt", GridFormat::TEXT},
+      {"convertTiled.geo", GridFormat::GEO_TILED}};
+
+  for (const auto &[name, format] : files)
+  {
+    // Odd block size, the last block is partial
+    const string path = (currentPath / name).string();
+    ASSERT_EQ(geo::ConvertGrid(inputPath, GridFormat::ESRI_ASCII, path, format, 37), geoStatus::SUCCESS) << name;
+
+    Grid loaded;
+    if (format == GridFormat::TEXT)
+    {
+      ASSERT_EQ(loaded.loadText(path, rows, columns, 0, 0, 1, 1), geoStatus::SUCCESS);
+    }
+    else
+    {
+      ASSERT_EQ(geo::LoadGrid(loaded, path, format), geoStatus::SUCCESS) << name;
+    }
+    EXPECT_EQ(loaded.dimensions(), grid.dimensions());
+    EXPECT_EQ(isSequentialGrid(loaded), true) << name;
+  }
+
+  // Back to ESRI ASCII from a binary grid, using automatic block size
+  const string asciiPath = (currentPath / "convertOutput.asc").string();
+  ASSERT_EQ(geo::ConvertGrid((currentPath / "convertSurfer6.grd").string(), GridFormat::SURFER_FLOAT, asciiPath, GridFormat::ESRI_ASCII), geoStatus::SUCCESS);
+  Grid ascii;
+  ASSERT_EQ(geo::LoadGrid(ascii, asciiPath), geoStatus::SUCCESS);
+  EXPECT_EQ(isSequentialGrid(ascii), true);
+
+  // NODATA cells become Surfer blanks
+  const string blankPath = (currentPath / "convertBlank.bil").string();
+  Grid withBlank = createTestGrid();
+  withBlank.c_float()[0] = NAN;
+  ASSERT_EQ(geo::SaveGrid(withBlank, blankPath, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  const string surferPath = (currentPath / "convertBlank.grd").string();
+  ASSERT_EQ(geo::ConvertGrid(blankPath, GridFormat::ESRI_FLOAT, surferPath, GridFormat::SURFER_FLOAT, 64), geoStatus::SUCCESS);
+  Grid surfer;
+  ASSERT_EQ(geo::LoadGrid(surfer, surferPath, GridFormat::SURFER_FLOAT), geoStatus::SUCCESS);
+  EXPECT_EQ(surfer(0, 0), geo::Surfer::nan);
+  EXPECT_EQ(surfer(rows - 1, columns - 1), rows * columns - 1);
+
+  // Big endian ESRI input: swap the cells and the byte order of the header
+  const string bigPath = (currentPath / "convertBig.bil").string();
+  ASSERT_EQ(geo::SaveGrid(grid, bigPath, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  {
+    std::fstream data(bigPath, std::ios::in | std::ios::out | std::ios::binary);
+    vector<char> bytes(rows * columns * sizeof(float));
+    data.read(bytes.data(), bytes.size());
+    for (size_t i = 0; i < bytes.size(); i += sizeof(float))
+    {
+      std::reverse(bytes.begin() + i, bytes.begin() + i + sizeof(float));
+    }
+    data.seekp(0);
+    data.write(bytes.data(), bytes.size());
+
+    const string headerPath = (currentPath / "convertBig.hdr").string();
+    std::ifstream in(headerPath);
+    string header((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    header = geo::Strings::replace(header, "byteorder      i", "byteorder      M");
+    std::ofstream(headerPath) << header;
+  }
+  const string littlePath = (currentPath / "convertLittle.flt").string();
+  ASSERT_EQ(geo::ConvertGrid(bigPath, GridFormat::ESRI_FLOAT, littlePath, GridFormat::ENVI_FLOAT, 100), geoStatus::SUCCESS);
+  Grid little;
+  ASSERT_EQ(geo::LoadGrid(little, littlePath, GridFormat::ENVI_FLOAT), geoStatus::SUCCESS);
+  EXPECT_EQ(isSequentialGrid(little), true);
+
+  // Loaders swap big endian cells, mapping falls back to reading
+  Grid big;
+  ASSERT_EQ(geo::LoadGrid(big, bigPath, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  EXPECT_EQ(isSequentialGrid(big), true);
+  Grid bigMapped;
+  ASSERT_EQ(geo::Esri::loadFloat(bigMapped, bigPath, true), geoStatus::SUCCESS);
+  EXPECT_EQ(isSequentialGrid(bigMapped), true);
+
+  // Big endian ENVI input
+  {
+    std::fstream data(littlePath, std::ios::in | std::ios::out | std::ios::binary);
+    vector<char> bytes(rows * columns * sizeof(float));
+    data.read(bytes.data(), bytes.size());
+    for (size_t i = 0; i < bytes.size(); i += sizeof(float))
+    {
+      std::reverse(bytes.begin() + i, bytes.begin() + i + sizeof(float));
+    }
+    data.seekp(0);
+    data.write(bytes.data(), bytes.size());
+
+    const string headerPath = (currentPath / "convertLittle.hdr").string();
+    std::ifstream in(headerPath);
+    string header((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    header = geo::Strings::replace(header, "byte order = 0", "byte order = 1");
+    std::ofstream(headerPath) << header;
+  }
+  Grid enviBig;
+  ASSERT_EQ(geo::LoadGrid(enviBig, littlePath, GridFormat::ENVI_FLOAT), geoStatus::SUCCESS);
+  EXPECT_EQ(isSequentialGrid(enviBig), true);
+  geo::BasicGrid<double> enviDouble;
+  ASSERT_EQ(geo::Envi::loadBinary(enviDouble, littlePath, false, true), geoStatus::SUCCESS);
+  EXPECT_EQ(enviDouble(rows - 1, columns - 1), rows * columns - 1);
+
+  // Missing inputs fail without leaving an output
+  const string missingPath = (currentPath / "convertMissing.bil").string();
+  EXPECT_EQ(geo::ConvertGrid((currentPath / "missing.asc").string(), GridFormat::ESRI_ASCII, missingPath, GridFormat::ESRI_FLOAT), geoStatus::FAILURE);
+  EXPECT_FALSE(fs::exists(missingPath));
+
+  // Blocks written in any order complete the file, rows written twice do not
+  const string blocksPath = (currentPath / "convertBlocks.bil").string();
+  Grid blocks = createSequentialGrid(GridFormat::ESRI_FLOAT, 6, 5, -76.5, 2.5, 270.0, 270.0);
+  {
+    geo::GridWriter writer;
+    ASSERT_EQ(writer.open(blocksPath, GridFormat::ESRI_FLOAT, 6, 5, -76.5, 2.5, 0.1, 0.1), geoStatus::SUCCESS);
+    EXPECT_EQ(writer.writeRows(3, 3, blocks.row(3)), geoStatus::SUCCESS);
+    EXPECT_EQ(writer.writeRows(0, 3, blocks.row(0)), geoStatus::SUCCESS);
+    EXPECT_EQ(writer.close(), geoStatus::SUCCESS);
+    Grid written;
+    ASSERT_EQ(geo::LoadGrid(written, blocksPath), geoStatus::SUCCESS);
+    EXPECT_TRUE(isSequentialGrid(written));
+  }
+  {
+    geo::GridWriter writer;
+    ASSERT_EQ(writer.open(blocksPath, GridFormat::ESRI_FLOAT, 6, 5, -76.5, 2.5, 0.1, 0.1), geoStatus::SUCCESS);
+    EXPECT_EQ(writer.writeRows(0, 3, blocks.row(0)), geoStatus::SUCCESS);
+    EXPECT_EQ(writer.writeRows(2, 1, blocks.row(2)), geoStatus::FAILURE);
+    EXPECT_EQ(writer.close(), geoStatus::FAILURE);
+    EXPECT_FALSE(fs::exists(blocksPath));
+  }
+}
+
+// Batch conversion on a pool of workers, largest files first
+TEST(GridTest, ConvertGrids)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  vector<geo::ConvertTask> tasks;
+  for (int size : {100, 300, 200})
+  {
+    const string name = "batch" + std::to_string(size);
+    const string input = (currentPath / (name + ".asc")).string();
+    ASSERT_EQ(geo::SaveGrid(createSequentialGrid(GridFormat::ESRI_ASCII, size, size, -76.0, 2.0, 90.0, 90.0), input, GridFormat::ESRI_ASCII), geoStatus::SUCCESS);
+    EXPECT_EQ(geo::getFormatFromPath(input), GridFormat::ESRI_ASCII);
+    tasks.push_back({input, GridFormat::ESRI_ASCII, (currentPath / (name + geo::getExtension(GridFormat::ENVI_FLOAT))).string(), GridFormat::ENVI_FLOAT});
+  }
+  tasks.push_back({(currentPath / "batchMissing.asc").string(), GridFormat::ESRI_ASCII, (currentPath / "batchMissing.flt").string(), GridFormat::ENVI_FLOAT});
+
+  int reported = 0;
+  EXPECT_EQ(geo::ConvertGrids(tasks, 2, [&](const geo::ConvertTask &)
+                              { reported++; }),
+            geoStatus::FAILURE);
+  EXPECT_EQ(reported, 4);
+
+  // Sorted by decreasing size, the missing file is last
+  ASSERT_EQ(tasks.size(), 4u);
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_EQ(tasks[i].status, geoStatus::SUCCESS) << tasks[i].input;
+    EXPECT_GT(tasks[i].size, tasks[i + 1].size);
+
+    Grid loaded;
+    ASSERT_EQ(geo::LoadGrid(loaded, tasks[i].output), geoStatus::SUCCESS);
+    EXPECT_EQ(loaded.dimensions(), std::make_tuple(300 - 100 * i, 300 - 100 * i));
+    EXPECT_EQ(isSequentialGrid(loaded), true);
+  }
+  EXPECT_EQ(tasks[3].status, geoStatus::FAILURE);
+}
+
+// Load the cells covering a bounding box
+TEST(GridTest, LoadBoundingBox)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  Grid grid = createTestGrid();
+  auto [rows, columns] = grid.dimensions();
+  auto [x0, y0, xMax, yMax] = grid.extents();
+  auto [dxDeg, dyDeg] = grid.resolutionDegrees();
+
+  // Box from the middle of column 200 to the middle of column 259, rows 100 to 149
+  auto bbox = std::make_tuple(x0 + 200.5 * dxDeg, y0 + 100.5 * dyDeg, x0 + 259.5 * dxDeg, y0 + 149.5 * dyDeg);
+
+  for (const string name : {"bboxEsri.bil", "bboxEnvi.flt", "bboxSurfer.grd", "bboxEsri.asc", "bboxTiled.geo"})
+  {
+    const string path = (currentPath / name).string();
+    ASSERT_EQ(geo::SaveGrid(grid, path, geo::getFormatFromPath(path)), geoStatus::SUCCESS);
+
+    Grid box;
+    ASSERT_EQ(geo::LoadGrid(box, path, bbox), geoStatus::SUCCESS) << name;
+    EXPECT_EQ(box.dimensions(), std::make_tuple(50, 60)) << name;
+
+    // Window is georeferenced from the header values
+    geo::GridReader reader(path);
+    auto [rx0, ry0, rxMax, ryMax] = reader.extents();
+    auto [rdxDeg, rdyDeg] = reader.resolutionDegrees();
+    auto [bx0, by0, bxMax, byMax] = box.extents();
+    EXPECT_DOUBLE_EQ(bx0, rx0 + 200 * rdxDeg);
+    EXPECT_DOUBLE_EQ(by0, ry0 + 100 * rdyDeg);
+    EXPECT_EQ(box(0, 0), 100 * columns + 200) << name;
+    EXPECT_EQ(box(49, 59), 149 * columns + 259) << name;
+  }
+
+  const string path = (currentPath / "bboxEsri.bil").string();
+  geo::GridReader reader(path);
+  std::tie(x0, y0, xMax, yMax) = reader.extents();
+  std::tie(dxDeg, dyDeg) = reader.resolutionDegrees();
+
+  // Boxes on cell edges do not take neighbour cells
+  Grid box;
+  ASSERT_EQ(geo::LoadGrid(box, path, GridFormat::ESRI_FLOAT, std::make_tuple(x0 + 10 * dxDeg, y0 + 20 * dyDeg, x0 + 15 * dxDeg, y0 + 30 * dyDeg)), geoStatus::SUCCESS);
+  EXPECT_EQ(box.dimensions(), std::make_tuple(10, 5));
+  EXPECT_EQ(box(0, 0), 20 * columns + 10);
+
+  // Boxes are clipped to the grid
+  ASSERT_EQ(geo::LoadGrid(box, path, std::make_tuple(xMax - 2.5 * dxDeg, yMax - 3.5 * dyDeg, xMax + 1.0, yMax + 1.0)), geoStatus::SUCCESS);
+  EXPECT_EQ(box.dimensions(), std::make_tuple(4, 3));
+  EXPECT_EQ(box(3, 2), rows * columns - 1);
+
+  // Boxes outside the grid fail
+  EXPECT_EQ(geo::LoadGrid(box, path, std::make_tuple(xMax + 1.0, y0, xMax + 2.0, yMax)), geoStatus::FAILURE);
+}
+
+// Header only metadata
+TEST(GridTest, ProbeGrid)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  Grid grid = createTestGrid();
+
+  const vector<std::tuple<string, GridFormat, geo::CellType>> files{
+      {"probeEsri.asc", GridFormat::ESRI_ASCII, geo::CellType::UNKNOWN},
+      {"probeEsri.bil", GridFormat::ESRI_FLOAT, geo::CellType::F32},
+      {"probeEnvi.flt", GridFormat::ENVI_DOUBLE, geo::CellType::F64},
+      {"probeSurfer.grd", GridFormat::SURFER_DOUBLE, geo::CellType::F64},
+      {"probeTiled.geo", GridFormat::GEO_TILED, geo::CellType::F32}};
+
+  for (const auto &[name, format, cellType] : files)
+  {
+    const string path = (currentPath / name).string();
+    ASSERT_EQ(geo::SaveGrid(grid, path, format), geoStatus::SUCCESS);
+
+    // Format and cell type are read from the header
+    geo::GridInfo info = geo::ProbeGrid(path);
+    ASSERT_TRUE(info.valid()) << name;
+    EXPECT_EQ(info.format, format) << name;
+    EXPECT_EQ(info.cellType, cellType) << name;
+    EXPECT_EQ(info.dimensions(), grid.dimensions());
+
+    // Same metadata as the loaded grid
+    Grid loaded;
+    ASSERT_EQ(geo::LoadGrid(loaded, path, format), geoStatus::SUCCESS);
+    auto [x0, y0, xMax, yMax] = loaded.extents();
+    auto [ix0, iy0, ixMax, iyMax] = info.extents();
+    EXPECT_NEAR(ix0, x0, 1e-9) << name;
+    EXPECT_NEAR(iy0, y0, 1e-9) << name;
+    EXPECT_NEAR(ixMax, xMax, 1e-9) << name;
+    EXPECT_NEAR(iyMax, yMax, 1e-9) << name;
+    EXPECT_EQ(info.position(x0 + (xMax - x0) * 0.3, y0 + (yMax - y0) * 0.6), loaded.position(x0 + (xMax - x0) * 0.3, y0 + (yMax - y0) * 0.6));
+  }
+
+  // Binary data follows the header
+  EXPECT_EQ(geo::ProbeGrid((currentPath / "probeEsri.bil").string()).dataOffset, 0u);
+  EXPECT_EQ(geo::ProbeGrid((currentPath / "probeEsri.bil").string()).fileOrder, geo::RowOrder::TOP_DOWN);
+  EXPECT_GT(geo::ProbeGrid((currentPath / "probeSurfer.grd").string(), GridFormat::SURFER_DOUBLE).dataOffset, 0u);
+
+  EXPECT_FALSE(geo::ProbeGrid((currentPath / "missing.bil").string()).valid());
+  EXPECT_FALSE(geo::ProbeGrid((currentPath / "probe.txt").string()).valid());
+}
+
+// Batch point sampling
+TEST(GridTest, Sample)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  Grid grid = createTestGrid();
+  auto [rows, columns] = grid.dimensions();
+  grid(10, 20) = grid.noDataValue();
+
+  // Same values from a grid kept in file order
+  const string path = (currentPath / "sample.bil").string();
+  ASSERT_EQ(geo::SaveGrid(grid, path, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  Grid topDown;
+  ASSERT_EQ(geo::LoadGrid(topDown, path), geoStatus::SUCCESS);
+  ASSERT_EQ(topDown.rowOrder(), geo::RowOrder::TOP_DOWN);
+
+  auto [x0, y0, xMax, yMax] = topDown.extents();
+  auto [dxDeg, dyDeg] = topDown.resolutionDegrees();
+
+  // Scattered points, some outside the grid, enough for several threads
+  const size_t n = 200000;
+  vector<double> lon(n);
+  vector<double> lat(n);
+  uint32_t state = 2463534242u;
+  for (size_t i = 0; i < n; i++)
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    lon[i] = x0 - 0.01 + (xMax - x0 + 0.02) * ((state & 0xFFFF) / 65535.0);
+    lat[i] = y0 - 0.01 + (yMax - y0 + 0.02) * ((state >> 16) / 65535.0);
+  }
+
+  // Cell centers, the NODATA cell and the north east corner
+  lon[0] = x0 + 20.5 * dxDeg;
+  lat[0] = y0 + 10.5 * dyDeg;
+  lon[1] = xMax;
+  lat[1] = yMax;
+  lon[2] = x0 + 7.5 * dxDeg;
+  lat[2] = y0 + 3.5 * dyDeg;
+
+  geo::setThreads(4);
+  for (bool sortPoints : {false, true})
+  {
+    vector<float> values(n);
+    topDown.sample(lon.data(), lat.data(), n, values.data(), sortPoints);
+
+    EXPECT_TRUE(std::isnan(values[0]));
+    EXPECT_EQ(values[1], rows * columns - 1);
+    EXPECT_EQ(values[2], 3 * columns + 7);
+
+    for (size_t i = 0; i < n; i++)
+    {
+      auto [column, row] = topDown.position(lon[i], lat[i]);
+      if (column < 0 || (column == 20 && row == 10))
+      {
+        EXPECT_TRUE(std::isnan(values[i])) << i;
+      }
+      else
+      {
+        EXPECT_EQ(values[i], topDown(row, column)) << i;
+      }
+    }
+  }
+  geo::setThreads(0);
+
+  // Typed grids are sampled as float
+  geo::BasicGrid<int16_t> typed = topDown.convert<int16_t>(-9999);
+  float value;
+  typed.sample(&lon[2], &lat[2], 1, &value);
+  EXPECT_EQ(value, static_cast<int16_t>(3 * columns + 7));
+}
+
+TEST(GridTest, Interpolate)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  // Sequential values are a plane: bilinear and bicubic reproduce it between the centers
+  const int rows = 60;
+  const int columns = 40;
+  Grid grid = createSequentialGrid(GridFormat::ESRI_FLOAT, rows, columns, -76.5, 2.5, 270.0, 270.0);
+
+  // Same values from a grid kept in file order
+  const string path = (currentPath / "interpolate.bil").string();
+  ASSERT_EQ(geo::SaveGrid(grid, path, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  Grid topDown;
+  ASSERT_EQ(geo::LoadGrid(topDown, path), geoStatus::SUCCESS);
+  ASSERT_EQ(topDown.rowOrder(), geo::RowOrder::TOP_DOWN);
+
+  auto [x0, y0, xMax, yMax] = topDown.extents();
+  auto [dxDeg, dyDeg] = topDown.resolutionDegrees();
+
+  // Expected value at a point, in cell center coordinates
+  auto plane = [&](double lon, double lat)
+  {
+    double u = ((lon - x0) / dxDeg) - 0.5;
+    double v = ((lat - y0) / dyDeg) - 0.5;
+    return (v * columns) + u;
+  };
+
+  // Interior points, outside points and the grid corners
+  const size_t n = 100000;
+  vector<double> lon(n);
+  vector<double> lat(n);
+  uint32_t state = 2463534242u;
+  for (size_t i = 0; i < n; i++)
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    lon[i] = x0 + (xMax - x0) * ((state & 0xFFFF) / 65535.0);
+    lat[i] = y0 + (yMax - y0) * ((state >> 16) / 65535.0);
+  }
+  lon[0] = x0 - dxDeg;
+  lat[0] = y0 + dyDeg;
+  lon[1] = x0;
+  lat[1] = y0;
+  lon[2] = xMax;
+  lat[2] = yMax;
+
+  geo::setThreads(4);
+  for (bool bicubic : {false, true})
+  {
+    vector<float> values(n);
+    if (bicubic)
+    {
+      topDown.sampleBicubic(lon.data(), lat.data(), n, values.data());
+    }
+    else
+    {
+      topDown.sampleBilinear(lon.data(), lat.data(), n, values.data());
+    }
+
+    EXPECT_TRUE(std::isnan(values[0]));
+    EXPECT_FLOAT_EQ(values[1], 0.0f);
+    EXPECT_FLOAT_EQ(values[2], rows * columns - 1);
+
+    for (size_t i = 3; i < n; i++)
+    {
+      double u = ((lon[i] - x0) / dxDeg) - 0.5;
+      double v = ((lat[i] - y0) / dyDeg) - 0.5;
+
+      // Bicubic needs two centers on each side
+      double margin = bicubic ? 1.0 : 0.0;
+      if (u >= margin && u <= columns - 1 - margin && v >= margin && v <= rows - 1 - margin)
+      {
+        ASSERT_NEAR(values[i], plane(lon[i], lat[i]), 5e-3) << i;
+      }
+
+      // Same result for single points
+      float single = bicubic ? topDown.sampleBicubic(lon[i], lat[i]) : topDown.sampleBilinear(lon[i], lat[i]);
+      ASSERT_EQ(values[i], single) << i;
+    }
+  }
+  geo::setThreads(0);
+
+  // Cell centers return the cell value
+  auto [gridX0, gridY0, gridXMax, gridYMax] = grid.extents();
+  auto [gridDx, gridDy] = grid.resolutionDegrees();
+  double lonCenter = gridX0 + 10.5 * gridDx;
+  double latCenter = gridY0 + 20.5 * gridDy;
+  EXPECT_FLOAT_EQ(grid.sampleBilinear(lonCenter, latCenter), grid(20, 10));
+  EXPECT_FLOAT_EQ(grid.sampleBicubic(lonCenter, latCenter), grid(20, 10));
+
+  // NODATA neighbours are left out: halfway between a NODATA center and a valid one
+  grid(20, 11) = grid.noDataValue();
+  EXPECT_FLOAT_EQ(grid.sampleBilinear(lonCenter + 0.5 * gridDx, latCenter), grid(20, 10));
+  float cubic = grid.sampleBicubic(lonCenter + 0.5 * gridDx, latCenter);
+  EXPECT_FALSE(std::isnan(cubic));
+  EXPECT_GT(cubic, grid(20, 9));
+  EXPECT_LT(cubic, grid(20, 12));
+
+  // All the neighbours NODATA
+  grid(20, 10) = grid.noDataValue();
+  grid(21, 10) = grid.noDataValue();
+  grid(21, 11) = grid.noDataValue();
+  EXPECT_TRUE(std::isnan(grid.sampleBilinear(lonCenter + 0.5 * gridDx, latCenter + 0.5 * gridDy)));
+  EXPECT_TRUE(std::isnan(grid.sampleBicubic(lonCenter + 0.5 * gridDx, latCenter + 0.5 * gridDy)));
+}
+
+TEST(GridTest, Resample)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const int rows = 60;
+  const int columns = 40;
+  Grid grid = createSequentialGrid(GridFormat::ESRI_FLOAT, rows, columns, -76.5, 2.5, 270.0, 270.0);
+  auto [dxDeg, dyDeg] = grid.resolutionDegrees();
+
+  // Same values from a grid kept in file order
+  const string path = (currentPath / "resample.bil").string();
+  ASSERT_EQ(geo::SaveGrid(grid, path, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  Grid topDown;
+  ASSERT_EQ(geo::LoadGrid(topDown, path), geoStatus::SUCCESS);
+  ASSERT_EQ(topDown.rowOrder(), geo::RowOrder::TOP_DOWN);
+
+  // Blocks of 3 x 2 cells, (3r, 2c) to (3r + 2, 2c + 1)
+  auto expected = [&](ResampleMethod method, int r, int c) -> float
+  {
+    switch (method)
+    {
+    case ResampleMethod::NEAREST:
+      return ((3 * r + 1) * columns) + (2 * c) + 1;
+    case ResampleMethod::BILINEAR:
+    case ResampleMethod::AVERAGE:
+      return ((3 * r + 1) * columns) + (2 * c) + 0.5f;
+    case ResampleMethod::MAX:
+      return ((3 * r + 2) * columns) + (2 * c) + 1;
+    default:
+      return (3 * r * columns) + (2 * c);
+    }
+  };
+
+  geo::setThreads(4);
+  for (ResampleMethod method : {ResampleMethod::NEAREST, ResampleMethod::BILINEAR, ResampleMethod::AVERAGE,
+                                ResampleMethod::MIN, ResampleMethod::MAX, ResampleMethod::MODE})
+  {
+    for (const Grid *source : {&grid, &topDown})
+    {
+      Grid resampled = source->resample(rows / 3, columns / 2, method);
+      ASSERT_EQ(resampled.dimensions(), std::make_tuple(rows / 3, columns / 2));
+      ASSERT_EQ(resampled.rowOrder(), geo::RowOrder::BOTTOM_UP);
+      EXPECT_NEAR(std::get<0>(resampled.resolutionDegrees()), std::get<0>(source->resolutionDegrees()) * 2, 1e-12);
+
+      for (int r = 0; r < rows / 3; r++)
+      {
+        for (int c = 0; c < columns / 2; c++)
+        {
+          ASSERT_NEAR(resampled(r, c), expected(method, r, c), 1e-3) << r << "," << c;
+        }
+      }
+    }
+  }
+
+  // Target resolution
+  Grid coarse = grid.resample(dxDeg * 2, dyDeg * 3, ResampleMethod::AVERAGE);
+  ASSERT_EQ(coarse.dimensions(), std::make_tuple(rows / 3, columns / 2));
+  EXPECT_FLOAT_EQ(coarse(5, 7), expected(ResampleMethod::AVERAGE, 5, 7));
+
+  // Upsampling takes the nearest value on all the methods
+  for (ResampleMethod method : {ResampleMethod::NEAREST, ResampleMethod::AVERAGE, ResampleMethod::MODE})
+  {
+    Grid fine = grid.resample(rows * 2, columns * 2, method);
+    ASSERT_EQ(fine.dimensions(), std::make_tuple(rows * 2, columns * 2));
+    EXPECT_EQ(fine(0, 0), grid(0, 0));
+    EXPECT_EQ(fine(41, 17), grid(20, 8));
+    EXPECT_EQ(fine(rows * 2 - 1, columns * 2 - 1), grid(rows - 1, columns - 1));
+  }
+  geo::setThreads(0);
+
+  // NODATA cells are left out, blocks without valid cells are NODATA
+  grid(0, 0) = grid.noDataValue();
+  for (int r = 3; r < 6; r++)
+  {
+    grid(r, 0) = grid.noDataValue();
+    grid(r, 1) = grid.noDataValue();
+  }
+  Grid average = grid.resample(rows / 3, columns / 2, ResampleMethod::AVERAGE);
+  EXPECT_FLOAT_EQ(average(0, 0), (1 + columns + columns + 1 + 2 * columns + 2 * columns + 1) / 5.0f);
+  EXPECT_TRUE(std::isnan(average(1, 0)));
+  EXPECT_FLOAT_EQ(grid.resample(rows / 3, columns / 2, ResampleMethod::MIN)(0, 0), 1);
+
+  // Most frequent value, ties resolved to the smallest one
+  grid(1, 0) = 7;
+  grid(2, 1) = 7;
+  EXPECT_EQ(grid.resample(rows / 3, columns / 2, ResampleMethod::MODE)(0, 0), 7);
+  EXPECT_EQ(grid.resample(rows / 3, columns / 2, ResampleMethod::MODE)(0, 1), 2);
+
+  // Typed grids
+  geo::BasicGrid<int16_t> typed = topDown.convert<int16_t>(-9999);
+  geo::BasicGrid<int16_t> typedMax = typed.resample(rows / 3, columns / 2, ResampleMethod::MAX);
+  EXPECT_EQ(typedMax(4, 3), expected(ResampleMethod::MAX, 4, 3));
+
+  // Parameters not valid
+  EXPECT_EQ(grid.resample(0, 10, ResampleMethod::AVERAGE).c_float(), nullptr);
+  EXPECT_EQ(grid.resample(-1.0, 1.0, ResampleMethod::AVERAGE).c_float(), nullptr);
+}
+
+TEST(GridTest, Overviews)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const int rows = 64;
+  const int columns = 48;
+  Grid grid = createSequentialGrid(GridFormat::ESRI_FLOAT, rows, columns, -76.5, 2.5, 270.0, 270.0);
+  grid(0, 0) = grid.noDataValue();
+
+  const string path = (currentPath / "overviews.bil").string();
+  ASSERT_EQ(geo::SaveGrid(grid, path, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  EXPECT_EQ(geo::OverviewPath(path, 4), (currentPath / "overviews.ovr4.bil").string());
+
+  // Overviews are not aggregated with mode
+  EXPECT_EQ(geo::BuildOverviews(path, ResampleMethod::MODE), geoStatus::FAILURE);
+
+  geo::setThreads(4);
+  ASSERT_EQ(geo::BuildOverviews(path, ResampleMethod::MAX, 3), geoStatus::SUCCESS);
+  geo::setThreads(0);
+  EXPECT_FALSE(fs::exists(geo::OverviewPath(path, 16)));
+
+  geo::GridInfo info = geo::ProbeGrid(path);
+  auto [dxDeg, dyDeg] = info.resolutionDegrees();
+
+  for (int factor : {2, 4, 8})
+  {
+    Grid overview;
+    ASSERT_EQ(geo::LoadGrid(overview, geo::OverviewPath(path, factor)), geoStatus::SUCCESS);
+    ASSERT_EQ(overview.dimensions(), std::make_tuple(rows / factor, columns / factor));
+
+    // Maximum of each block of factor x factor cells, NODATA left out
+    for (int r = 0; r < rows / factor; r++)
+    {
+      for (int c = 0; c < columns / factor; c++)
+      {
+        ASSERT_EQ(overview(r, c), ((r * factor + factor - 1) * columns) + (c * factor) + factor - 1) << factor;
+      }
+    }
+  }
+
+  // Coarsest level at least as fine as the requested resolution
+  EXPECT_EQ(geo::SelectOverview(path, dxDeg, dyDeg), path);
+  EXPECT_EQ(geo::SelectOverview(path, dxDeg * 3, dyDeg * 3), geo::OverviewPath(path, 2));
+  EXPECT_EQ(geo::SelectOverview(path, dxDeg * 4, dyDeg * 4), geo::OverviewPath(path, 4));
+  EXPECT_EQ(geo::SelectOverview(path, dxDeg * 100, dyDeg * 100), geo::OverviewPath(path, 8));
+
+  Grid coarse;
+  ASSERT_EQ(geo::LoadOverview(coarse, path, dxDeg * 8, dyDeg * 8), geoStatus::SUCCESS);
+  EXPECT_EQ(coarse.dimensions(), std::make_tuple(rows / 8, columns / 8));
+
+  // Window of the 4x level
+  auto [x0, y0, xMax, yMax] = info.extents();
+  Grid window;
+  ASSERT_EQ(geo::LoadOverview(window, path, dxDeg * 4, dyDeg * 4, {x0, y0, x0 + 7.5 * dxDeg, y0 + 7.5 * dyDeg}), geoStatus::SUCCESS);
+  EXPECT_EQ(window.dimensions(), std::make_tuple(2, 2));
+  EXPECT_EQ(window(1, 1), (7 * columns) + 7);
+
+  // The levels are recorded on the stamp sidecar
+  ASSERT_TRUE(fs::exists(geo::OverviewStampPath(path)));
+  EXPECT_EQ(fs::file_size(geo::OverviewStampPath(path)), geo::overviewStampSize);
+
+  // Overviews of a replaced grid are ignored, even when the grid is older than the overviews
+  Grid replaced = grid;
+  replaced(5, 5) += 1.0f;
+  ASSERT_EQ(geo::SaveGrid(replaced, path, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  fs::last_write_time(path, fs::last_write_time(geo::OverviewPath(path, 2)) - std::chrono::hours(1));
+  EXPECT_EQ(geo::SelectOverview(path, dxDeg * 8, dyDeg * 8), path);
+
+  // Missing stamp
+  ASSERT_EQ(geo::SaveGrid(grid, path, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::BuildOverviews(path, ResampleMethod::MAX, 3), geoStatus::SUCCESS);
+  EXPECT_EQ(geo::SelectOverview(path, dxDeg * 8, dyDeg * 8), geo::OverviewPath(path, 8));
+  fs::remove(geo::OverviewStampPath(path));
+  EXPECT_EQ(geo::SelectOverview(path, dxDeg * 8, dyDeg * 8), path);
+
+  // Levels reduced from the previous one match the full resolution resample, partial and NODATA cells included
+  Grid odd = createSequentialGrid(GridFormat::ESRI_FLOAT, 37, 53, -76.5, 2.5, 270.0, 270.0);
+  odd.setNoData(-9999.0f);
+  for (int k = 0; k < 37 * 53; k += 7)
+  {
+    odd(k / 53, k % 53) = odd.noDataValue();
+  }
+  const string oddPath = (currentPath / "overviewsOdd.bil").string();
+  ASSERT_EQ(geo::SaveGrid(odd, oddPath, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  auto [oddDx, oddDy] = odd.resolutionDegrees();
+  for (ResampleMethod method : {ResampleMethod::AVERAGE, ResampleMethod::MIN, ResampleMethod::MAX})
+  {
+    ASSERT_EQ(geo::BuildOverviews(oddPath, method, 4), geoStatus::SUCCESS);
+    for (int factor : {2, 4, 8, 16})
+    {
+      Grid overview;
+      ASSERT_EQ(geo::LoadGrid(overview, geo::OverviewPath(oddPath, factor)), geoStatus::SUCCESS);
+      Grid expected = odd.resample(oddDx * factor, oddDy * factor, method);
+      ASSERT_EQ(overview.dimensions(), expected.dimensions()) << factor;
+      auto [overviewRows, overviewColumns] = overview.dimensions();
+      for (int r = 0; r < overviewRows; r++)
+      {
+        for (int c = 0; c < overviewColumns; c++)
+        {
+          ASSERT_FLOAT_EQ(overview(r, c), expected(r, c)) << factor << " " << r << " " << c;
+        }
+      }
+    }
+  }
+
+  // Averages carry the count of valid full resolution cells, they are not averages of averages
+  ASSERT_EQ(geo::BuildOverviews(path, ResampleMethod::AVERAGE, 2), geoStatus::SUCCESS);
+  const float average = ((4 * columns * 6) + (4 * 6)) / 15.0f;
+  Grid averaged;
+  ASSERT_EQ(geo::LoadGrid(averaged, geo::OverviewPath(path, 4)), geoStatus::SUCCESS);
+  EXPECT_FLOAT_EQ(averaged(0, 0), average);
+
+  // Tiled grids are read from their embedded levels, no overview files are written
+  const string tiledPath = (currentPath / "overviews.geo").string();
+  ASSERT_EQ(geo::GeoTiled::save(grid, tiledPath, 16), geoStatus::SUCCESS);
+  EXPECT_EQ(geo::BuildOverviews(tiledPath), geoStatus::FAILURE);
+  EXPECT_FALSE(fs::exists(geo::OverviewPath(tiledPath, 2)));
+  EXPECT_EQ(geo::SelectOverview(tiledPath, dxDeg * 4, dyDeg * 4), tiledPath);
+  EXPECT_EQ(geo::SelectLevel(tiledPath, dxDeg, dyDeg), 0);
+  EXPECT_EQ(geo::SelectLevel(tiledPath, dxDeg * 3, dyDeg * 3), 1);
+  EXPECT_EQ(geo::SelectLevel(tiledPath, dxDeg * 100, dyDeg * 100), 2);
+
+  Grid level;
+  ASSERT_EQ(geo::LoadOverview(level, tiledPath, dxDeg * 4, dyDeg * 4), geoStatus::SUCCESS);
+  EXPECT_EQ(level.dimensions(), std::make_tuple(rows / 4, columns / 4));
+  EXPECT_FLOAT_EQ(level(0, 0), average);
+  EXPECT_FLOAT_EQ(level(1, 1), (5.5f * columns) + 5.5f);
+
+  Grid levelWindow;
+  ASSERT_EQ(geo::LoadOverview(levelWindow, tiledPath, dxDeg * 4, dyDeg * 4, {x0, y0, x0 + 7.5 * dxDeg, y0 + 7.5 * dyDeg}), geoStatus::SUCCESS);
+  EXPECT_EQ(levelWindow.dimensions(), std::make_tuple(2, 2));
+  EXPECT_FLOAT_EQ(levelWindow(1, 1), (5.5f * columns) + 5.5f);
+}
+
+TEST(GridTest, CompareGrids)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  Grid gridA = createTestGrid();
+  Grid gridB = gridA;
+  auto [rows, columns] = gridA.dimensions();
+
+  // Changes below and above the tolerances, NaN, infinity and values near to zero
+  uint32_t state = 2463534242u;
+  for (int k = 0; k < 2000; k++)
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    int row = static_cast<int>(state % rows);
+    int column = static_cast<int>((state >> 9) % columns);
+    switch (k % 6)
+    {
+    case 0:
+      gridB(row, column) += 0.5f;
+      break;
+    case 1:
+      gridB(row, column) *= 1.02f;
+      break;
+    case 2:
+      gridB(row, column) = NAN;
+      break;
+    case 3:
+      gridA(row, column) = NAN;
+      gridB(row, column) = NAN;
+      break;
+    case 4:
+      gridA(row, column) = INFINITY;
+      gridB(row, column) = -INFINITY;
+      break;
+    default:
+      gridA(row, column) = 1e-9f;
+      gridB(row, column) = -1e-9f;
+    }
+  }
+
+  // Same values with the rows in file order
+  const string path = (currentPath / "compare.bil").string();
+  ASSERT_EQ(geo::SaveGrid(gridB, path, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  Grid topDown;
+  ASSERT_EQ(geo::LoadGrid(topDown, path), geoStatus::SUCCESS);
+  ASSERT_EQ(topDown.rowOrder(), geo::RowOrder::TOP_DOWN);
+
+  geo::setThreads(4);
+  for (CompareMode mode : {CompareMode::ABSOLUTE, CompareMode::RELATIVE})
+  {
+    float tolerance = (mode == CompareMode::ABSOLUTE) ? 0.1f : 1.0f;
+
+    // Cell by cell reference
+    vector<size_t> expected;
+    for (int i = 0; i < rows; i++)
+    {
+      for (int j = 0; j < columns; j++)
+      {
+        bool equal = (mode == CompareMode::ABSOLUTE) ? gridA.same(gridB, i, j, tolerance) : gridA.equalsAt(gridB, i, j, tolerance);
+        if (!equal)
+        {
+          expected.push_back((static_cast<size_t>(i) * columns) + j);
+        }
+      }
+    }
+    ASSERT_FALSE(expected.empty());
+
+    for (const Grid *other : {&gridB, &topDown})
+    {
+      EXPECT_EQ(gridA.countDifferences(*other, mode, tolerance), expected.size());
+      EXPECT_TRUE(gridA.differs(*other, mode, tolerance));
+      EXPECT_EQ(gridA.differences(*other, mode, tolerance), expected);
+
+      vector<size_t> first = gridA.differences(*other, mode, tolerance, 10);
+      EXPECT_EQ(first, vector<size_t>(expected.begin(), expected.begin() + 10));
+
+      vector<uint64_t> mask = gridA.differenceMask(*other, mode, tolerance);
+      ASSERT_EQ(mask.size(), (static_cast<size_t>(rows) * columns + 63) / 64);
+      size_t bits = 0;
+      for (uint64_t word : mask)
+      {
+        bits += std::bitset<64>(word).count();
+      }
+      EXPECT_EQ(bits, expected.size());
+      for (size_t index : expected)
+      {
+        EXPECT_TRUE((mask[index / 64] >> (index % 64)) & 1) << index;
+      }
+    }
+
+    EXPECT_EQ(gridA.countDifferences(gridA, mode, tolerance), 0u);
+    EXPECT_FALSE(gridA.differs(gridA, mode, tolerance));
+    EXPECT_TRUE(gridA.differences(gridA, mode, tolerance).empty());
+  }
+  geo::setThreads(0);
+
+  // Dimensions are different
+  Grid small = createSequentialGrid(GridFormat::ESRI_FLOAT, 10, 10, -76.5, 2.5, 270.0, 270.0);
+  EXPECT_EQ(gridA.countDifferences(small, CompareMode::ABSOLUTE, 0.1f), std::numeric_limits<size_t>::max());
+  EXPECT_TRUE(gridA.differs(small, CompareMode::ABSOLUTE, 0.1f));
+  EXPECT_TRUE(gridA.differenceMask(small, CompareMode::ABSOLUTE, 0.1f).empty());
+}
+
+// Grid diff statistics
+TEST(GridTest, Diff)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const int rows = 120;
+  const int columns = 150;
+  Grid gridA = createSequentialGrid(GridFormat::ESRI_FLOAT, rows, columns, -76.5, 2.5, 270.0, 270.0);
+  gridA.setNoData(-9999.0f);
+  Grid gridB = gridA;
+
+  // Changes below and above the tolerance, NODATA on one grid and on both grids
+  uint32_t state = 2463534242u;
+  for (int k = 0; k < 1500; k++)
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    int row = static_cast<int>(state % rows);
+    int column = static_cast<int>((state >> 9) % columns);
+    switch (k % 5)
+    {
+    case 0:
+      gridB(row, column) += 0.5f;
+      break;
+    case 1:
+      gridB(row, column) -= 0.01f * (k % 7);
+      break;
+    case 2:
+      gridB(row, column) = -9999.0f;
+      break;
+    case 3:
+      gridA(row, column) = -9999.0f;
+      gridB(row, column) = -9999.0f;
+      break;
+    default:
+      gridA(row, column) = -9999.0f;
+    }
+  }
+
+  // Same values with the rows in file order
+  const string path = (currentPath / "diff.bil").string();
+  ASSERT_EQ(geo::SaveGrid(gridB, path, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  Grid topDown;
+  ASSERT_EQ(geo::LoadGrid(topDown, path), geoStatus::SUCCESS);
+  ASSERT_EQ(topDown.rowOrder(), geo::RowOrder::TOP_DOWN);
+
+  const float tolerance = 0.1f;
+
+  // Cell by cell reference
+  size_t compared = 0;
+  size_t different = 0;
+  size_t mismatches = 0;
+  double sum = 0.0;
+  double sumAbsolute = 0.0;
+  double sumSquares = 0.0;
+  double maxError = 0.0;
+  std::array<size_t, 6> bins{};
+  for (int i = 0; i < rows; i++)
+  {
+    for (int j = 0; j < columns; j++)
+    {
+      bool dataA = gridA(i, j) != -9999.0f;
+      bool dataB = gridB(i, j) != -9999.0f;
+      if (dataA != dataB)
+      {
+        mismatches++;
+        different++;
+      }
+      if (!dataA || !dataB)
+      {
+        continue;
+      }
+      double error = static_cast<double>(gridA(i, j)) - gridB(i, j);
+      double relative = (error == 0.0) ? 0.0 : std::fabs(error / gridA(i, j)) * 100.0;
+      compared++;
+      different += !gridA.same(gridB, i, j, tolerance);
+      sum += error;
+      sumAbsolute += std::fabs(error);
+      sumSquares += error * error;
+      maxError = std::max(maxError, std::fabs(error));
+      size_t bin = 0;
+      while (bin < geo::GridDiff::relativeErrorLimits.size() && relative >= geo::GridDiff::relativeErrorLimits[bin])
+      {
+        bin++;
+      }
+      bins[bin]++;
+    }
+  }
+  ASSERT_GT(mismatches, 0u);
+
+  geo::setThreads(4);
+  for (const Grid *other : {&gridB, &topDown})
+  {
+    geo::GridDiff result = gridA.diff(*other, CompareMode::ABSOLUTE, tolerance, 5);
+    ASSERT_TRUE(result.valid());
+    EXPECT_EQ(result.cells, static_cast<size_t>(rows) * columns);
+    EXPECT_EQ(result.compared, compared);
+    EXPECT_EQ(result.different, different);
+    EXPECT_EQ(result.noDataMismatches, mismatches);
+    EXPECT_DOUBLE_EQ(result.maxError, maxError);
+    EXPECT_NEAR(result.meanError, sum / compared, 1e-9);
+    EXPECT_NEAR(result.meanAbsoluteError, sumAbsolute / compared, 1e-9);
+    EXPECT_NEAR(result.rmse, std::sqrt(sumSquares / compared), 1e-9);
+    EXPECT_EQ(result.relativeErrors, bins);
+
+    // Worst cells, largest first
+    ASSERT_EQ(result.worst.size(), 5u);
+    EXPECT_DOUBLE_EQ(result.worst.front().error, maxError);
+    for (size_t k = 0; k < result.worst.size(); k++)
+    {
+      const geo::DiffCell &cell = result.worst[k];
+      EXPECT_DOUBLE_EQ(cell.a, gridA(cell.row, cell.column));
+      EXPECT_DOUBLE_EQ(cell.b, gridB(cell.row, cell.column));
+      EXPECT_DOUBLE_EQ(cell.error, std::fabs(cell.a - cell.b));
+      if (k > 0)
+      {
+        EXPECT_GE(result.worst[k - 1].error, cell.error);
+      }
+    }
+
+    // Difference and mask rasters on the same pass
+    geo::BasicGrid<float> difference, mask;
+    EXPECT_EQ(gridA.diff(*other, CompareMode::ABSOLUTE, tolerance, geo::DiffRaster::DIFFERENCE, difference).different, different);
+    EXPECT_EQ(gridA.diff(*other, CompareMode::ABSOLUTE, tolerance, geo::DiffRaster::MASK, mask).different, different);
+    ASSERT_TRUE(difference.equalDimensions(gridA));
+    ASSERT_TRUE(mask.equalDimensions(gridA));
+    size_t masked = 0;
+    for (int i = 0; i < rows; i++)
+    {
+      for (int j = 0; j < columns; j++)
+      {
+        bool dataA = gridA(i, j) != -9999.0f;
+        bool dataB = gridB(i, j) != -9999.0f;
+        if (dataA && dataB)
+        {
+          EXPECT_FLOAT_EQ(difference(i, j), gridA(i, j) - gridB(i, j));
+        }
+        else
+        {
+          EXPECT_TRUE(std::isnan(difference(i, j)));
+        }
+        masked += (mask(i, j) == 1.0f);
+      }
+    }
+    EXPECT_EQ(masked, different);
+  }
+
+  // Without differences, relative mode matches countDifferences()
+  geo::GridDiff same = gridA.diff(gridA, CompareMode::RELATIVE, 1.0f);
+  EXPECT_EQ(same.different, 0u);
+  EXPECT_EQ(same.maxError, 0.0);
+  EXPECT_TRUE(same.worst.empty());
+  EXPECT_EQ(same.relativeErrors[0], same.compared);
+  geo::setThreads(0);
+
+  // Saved through SaveGrid
+  geo::BasicGrid<float> difference;
+  gridA.diff(gridB, CompareMode::ABSOLUTE, tolerance, geo::DiffRaster::DIFFERENCE, difference);
+  const string differencePath = (currentPath / "difference.flt").string();
+  ASSERT_EQ(geo::SaveGrid(difference, differencePath, GridFormat::ENVI_FLOAT), geoStatus::SUCCESS);
+
+  // Listing with the NODATA rules of the statistics, grids with other NODATA values
+  Grid noDataA = createSequentialGrid(GridFormat::ESRI_FLOAT, 4, 4, -76.5, 2.5, 270.0, 270.0);
+  Grid noDataB = noDataA;
+  noDataA.setNoData(-9999.0f);
+  noDataB.setNoData(-32768.0f);
+  noDataA(1, 1) = -9999.0f;
+  noDataB(1, 1) = -32768.0f;
+  noDataB(2, 1) += 1.0f;
+  for (size_t limit : {size_t(1), size_t(100)})
+  {
+    vector<geo::DiffCell> cells;
+    geo::GridDiff result = noDataA.diff(noDataB, CompareMode::ABSOLUTE, tolerance, cells, limit);
+    EXPECT_EQ(result.different, 1u);
+    ASSERT_EQ(cells.size(), 1u);
+    EXPECT_EQ(cells[0].row, 2);
+    EXPECT_EQ(cells[0].column, 1);
+    EXPECT_DOUBLE_EQ(cells[0].error, 1.0);
+  }
+
+  // Listing agrees with the count and the mask
+  vector<geo::DiffCell> cells;
+  geo::BasicGrid<float> listedMask;
+  geo::GridDiff listed = gridA.diff(gridB, CompareMode::ABSOLUTE, tolerance, cells, std::numeric_limits<size_t>::max());
+  gridA.diff(gridB, CompareMode::ABSOLUTE, tolerance, geo::DiffRaster::MASK, listedMask);
+  ASSERT_EQ(cells.size(), listed.different);
+  for (size_t k = 0; k < cells.size(); k++)
+  {
+    EXPECT_EQ(listedMask(cells[k].row, cells[k].column), 1.0f);
+    if (k > 0)
+    {
+      EXPECT_LT(std::tie(cells[k - 1].row, cells[k - 1].column), std::tie(cells[k].row, cells[k].column));
+    }
+  }
+  vector<geo::DiffCell> first;
+  gridA.diff(gridB, CompareMode::ABSOLUTE, tolerance, first, 10);
+  ASSERT_EQ(first.size(), 10u);
+  for (size_t k = 0; k < first.size(); k++)
+  {
+    EXPECT_EQ(first[k].row, cells[k].row);
+    EXPECT_EQ(first[k].column, cells[k].column);
+  }
+
+  // Dimensions are different
+  Grid small = createSequentialGrid(GridFormat::ESRI_FLOAT, 10, 10, -76.5, 2.5, 270.0, 270.0);
+  EXPECT_FALSE(gridA.diff(small, CompareMode::ABSOLUTE, tolerance).valid());
+  EXPECT_FALSE(gridA.diff(small, CompareMode::ABSOLUTE, tolerance, geo::DiffRaster::MASK, difference).valid());
+  EXPECT_EQ(std::get<0>(difference.dimensions()), 0);
+}
+
+// Out of core diff of two grid files
+TEST(GridTest, StreamDiff)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  const int rows = 97;
+  const int columns = 130;
+  Grid gridA = createSequentialGrid(GridFormat::ESRI_FLOAT, rows, columns, -76.5, 2.5, 270.0, 270.0);
+  gridA.setNoData(-9999.0f);
+  Grid gridB = gridA;
+
+  uint32_t state = 2463534242u;
+  for (int k = 0; k < 800; k++)
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    int row = static_cast<int>(state % rows);
+    int column = static_cast<int>((state >> 9) % columns);
+    switch (k % 4)
+    {
+    case 0:
+      gridB(row, column) += 0.5f;
+      break;
+    case 1:
+      gridB(row, column) -= 0.05f * (k % 5);
+      break;
+    case 2:
+      gridB(row, column) = -9999.0f;
+      break;
+    default:
+      gridA(row, column) = -9999.0f;
+    }
+  }
+
+  // Text (bottom up in memory) and binary (top down) files
+  const string pathA = (currentPath / "streamA.asc").string();
+  const string pathB = (currentPath / "streamB.bil").string();
+  ASSERT_EQ(geo::SaveGrid(gridA, pathA, GridFormat::ESRI_ASCII), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::SaveGrid(gridB, pathB, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+
+  // In memory reference, from the saved files
+  Grid loadedA, loadedB;
+  ASSERT_EQ(geo::LoadGrid(loadedA, pathA), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::LoadGrid(loadedB, pathB), geoStatus::SUCCESS);
+
+  for (CompareMode mode : {CompareMode::ABSOLUTE, CompareMode::RELATIVE})
+  {
+    float tolerance = (mode == CompareMode::ABSOLUTE) ? 0.1f : 1.0f;
+    geo::GridDiff expected = loadedA.diff(loadedB, mode, tolerance, 8);
+    vector<size_t> expectedCells = loadedA.differences(loadedB, mode, tolerance, 50);
+    ASSERT_GT(expected.different, 0u);
+
+    // Blocks smaller than the grid, rows read in both orders
+    for (int blockRows : {0, 1, 7, 40})
+    {
+      for (bool swap : {false, true})
+      {
+        geo::GridDiff result;
+        vector<geo::DiffCell> cells;
+        const string &first = swap ? pathB : pathA;
+        const string &second = swap ? pathA : pathB;
+        ASSERT_EQ(geo::DiffGrids(first, second, mode, tolerance, result, &cells, 50, 8, blockRows), geoStatus::SUCCESS);
+        geo::GridDiff reference = swap ? loadedB.diff(loadedA, mode, tolerance, 8) : expected;
+        vector<size_t> referenceCells = swap ? loadedB.differences(loadedA, mode, tolerance, 50) : expectedCells;
+
+        ASSERT_TRUE(result.valid());
+        EXPECT_EQ(result.cells, reference.cells);
+        EXPECT_EQ(result.compared, reference.compared);
+        EXPECT_EQ(result.different, reference.different);
+        EXPECT_EQ(result.noDataMismatches, reference.noDataMismatches);
+        EXPECT_DOUBLE_EQ(result.maxError, reference.maxError);
+        EXPECT_NEAR(result.meanError, reference.meanError, 1e-9);
+        EXPECT_NEAR(result.meanAbsoluteError, reference.meanAbsoluteError, 1e-9);
+        EXPECT_NEAR(result.rmse, reference.rmse, 1e-9);
+        EXPECT_EQ(result.relativeErrors, reference.relativeErrors);
+
+        ASSERT_EQ(result.worst.size(), reference.worst.size());
+        for (size_t k = 0; k < result.worst.size(); k++)
+        {
+          EXPECT_EQ(result.worst[k].row, reference.worst[k].row);
+          EXPECT_EQ(result.worst[k].column, reference.worst[k].column);
+          EXPECT_DOUBLE_EQ(result.worst[k].error, reference.worst[k].error);
+        }
+
+        ASSERT_EQ(cells.size(), referenceCells.size());
+        for (size_t k = 0; k < cells.size(); k++)
+        {
+          EXPECT_EQ(static_cast<size_t>(cells[k].row) * columns + cells[k].column, referenceCells[k]);
+          EXPECT_DOUBLE_EQ(cells[k].a, (swap ? loadedB : loadedA)(cells[k].row, cells[k].column));
+          EXPECT_DOUBLE_EQ(cells[k].b, (swap ? loadedA : loadedB)(cells[k].row, cells[k].column));
+        }
+      }
+    }
+  }
+
+  // Listing with the NODATA rules of the statistics, grids with other NODATA values
+  Grid noDataA = createSequentialGrid(GridFormat::ESRI_FLOAT, 4, 4, -76.5, 2.5, 270.0, 270.0);
+  Grid noDataB = noDataA;
+  noDataA.setNoData(-9999.0f);
+  noDataB.setNoData(-32768.0f);
+  noDataA(1, 1) = -9999.0f;
+  noDataB(1, 1) = -32768.0f;
+  noDataB(2, 1) += 1.0f;
+  const string noDataPathA = (currentPath / "streamNoDataA.bil").string();
+  const string noDataPathB = (currentPath / "streamNoDataB.asc").string();
+  ASSERT_EQ(geo::SaveGrid(noDataA, noDataPathA, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::SaveGrid(noDataB, noDataPathB, GridFormat::ESRI_ASCII), geoStatus::SUCCESS);
+  for (int blockRows : {0, 1})
+  {
+    geo::GridDiff result;
+    vector<geo::DiffCell> cells;
+    ASSERT_EQ(geo::DiffGrids(noDataPathA, noDataPathB, CompareMode::ABSOLUTE, 0.1f, result, &cells, 100, 10, blockRows), geoStatus::SUCCESS);
+    EXPECT_EQ(result.different, 1u);
+    ASSERT_EQ(cells.size(), 1u);
+    EXPECT_EQ(cells[0].row, 2);
+    EXPECT_EQ(cells[0].column, 1);
+  }
+
+  // Stop on the first block with differences, equal grids are read to the end
+  for (int blockRows : {1, 7})
+  {
+    geo::GridDiff first;
+    ASSERT_EQ(geo::DiffGrids(pathA, pathB, CompareMode::ABSOLUTE, 0.1f, first, nullptr, 0, 0, blockRows, true), geoStatus::SUCCESS);
+    EXPECT_GT(first.different, 0u);
+    EXPECT_LT(first.cells, static_cast<size_t>(rows) * columns);
+
+    geo::GridDiff same;
+    ASSERT_EQ(geo::DiffGrids(pathA, pathA, CompareMode::ABSOLUTE, 0.1f, same, nullptr, 0, 0, blockRows, true), geoStatus::SUCCESS);
+    EXPECT_EQ(same.different, 0u);
+    EXPECT_EQ(same.cells, static_cast<size_t>(rows) * columns);
+  }
+
+  // Dimensions are different, missing files
+  Grid small = createSequentialGrid(GridFormat::ESRI_FLOAT, 10, 10, -76.5, 2.5, 270.0, 270.0);
+  const string smallPath = (currentPath / "streamSmall.bil").string();
+  ASSERT_EQ(geo::SaveGrid(small, smallPath, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  geo::GridDiff result;
+  EXPECT_EQ(geo::DiffGrids(pathA, smallPath, CompareMode::ABSOLUTE, 0.1f, result), geoStatus::SUCCESS);
+  EXPECT_FALSE(result.valid());
+  EXPECT_EQ(geo::DiffGrids(pathA, (currentPath / "missing.bil").string(), CompareMode::ABSOLUTE, 0.1f, result), geoStatus::FAILURE);
+}
+
+// Block content hashes and sidecars
+TEST(GridTest, Hashes)
+{
+  // Create grid folder
+  createGridFolder();
+
+  // Use "grids/" folder
+  fs::path currentPath(fs::current_path() / "grids");
+
+  // Fail and stop if the output directory does not exist
+  ASSERT_TRUE(fs::is_directory(currentPath));
+
+  // XXH64 reference values
+  EXPECT_EQ(geo::Hash::xxh64("", 0), 0xEF46DB3751D8E999ULL);
+  EXPECT_EQ(geo::Hash::xxh64("a", 1), 0xD24EC4F1A98C6E5BULL);
+  EXPECT_EQ(geo::Hash::xxh64("abc", 3), 0x44BC2CF5AD770999ULL);
+  EXPECT_EQ(geo::Hash::xxh64("Nobody inspects the spammish repetition", 39), 0xFBCEA83C8A378BF1ULL);
+
+  const int rows = 150;
+  const int columns = 90;
+  const int blockRows = 32;
+  Grid gridA = createSequentialGrid(GridFormat::ESRI_FLOAT, rows, columns, -76.5, 2.5, 270.0, 270.0);
+  gridA.setNoData(-9999.0f);
+  gridA(3, 4) = -9999.0f;
+
+  geo::GridHashes hashes = gridA.hashes(blockRows);
+  ASSERT_TRUE(hashes.valid());
+  EXPECT_EQ(hashes.blocks(), 5);
+  uint64_t dataCells = 0;
+  for (uint64_t cells : hashes.dataCells)
+  {
+    dataCells += cells;
+  }
+  EXPECT_EQ(dataCells, static_cast<uint64_t>(rows) * columns - 1);
+
+  // Only the block of the changed cell has another hash
+  Grid gridB = gridA;
+  gridB(100, 7) += 0.5f;
+  geo::GridHashes changed = gridB.hashes(blockRows);
+  ASSERT_TRUE(hashes.comparable(changed));
+  EXPECT_FALSE(hashes.identical(changed));
+  for (int block = 0; block < hashes.blocks(); block++)
+  {
+    EXPECT_EQ(hashes.hashes[block] == changed.hashes[block], block != 100 / blockRows) << block;
+  }
+
+  // Sidecars built from the files match the loaded grids, in any row order
+  const string pathA = (currentPath / "hashA.bil").string();
+  const string pathB = (currentPath / "hashB.asc").string();
+  ASSERT_EQ(geo::SaveGrid(gridA, pathA, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::SaveGrid(gridB, pathB, GridFormat::ESRI_ASCII), geoStatus::SUCCESS);
+  Grid loadedA, loadedB;
+  ASSERT_EQ(geo::LoadGrid(loadedA, pathA), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::LoadGrid(loadedB, pathB), geoStatus::SUCCESS);
+  EXPECT_EQ(loadedA.hashes(blockRows).hashes, hashes.hashes);
+
+  ASSERT_EQ(geo::BuildHashes(pathA, blockRows), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::BuildHashes(pathB, blockRows), geoStatus::SUCCESS);
+  geo::GridHashes loaded;
+  ASSERT_EQ(geo::LoadHashes(pathA, loaded), geoStatus::SUCCESS);
+  EXPECT_EQ(loaded.hashes, hashes.hashes);
+  EXPECT_EQ(loaded.dataCells, hashes.dataCells);
+  EXPECT_EQ(loaded.noData, -9999.0);
+  ASSERT_EQ(geo::LoadHashes(pathB, loaded), geoStatus::SUCCESS);
+  EXPECT_EQ(loaded.hashes, loadedB.hashes(blockRows).hashes);
+  EXPECT_FALSE(geo::IdenticalGrids(pathA, pathB));
+
+  // Diff skipping the identical blocks, same results as without sidecars
+  for (CompareMode mode : {CompareMode::ABSOLUTE, CompareMode::RELATIVE})
+  {
+    float tolerance = (mode == CompareMode::ABSOLUTE) ? 0.1f : 1.0f;
+    geo::GridDiff expected = loadedA.diff(loadedB, mode, tolerance);
+    geo::GridDiff result;
+    vector<geo::DiffCell> cells;
+    ASSERT_EQ(geo::DiffGrids(pathA, pathB, mode, tolerance, result, &cells), geoStatus::SUCCESS);
+    EXPECT_EQ(result.cells, expected.cells);
+    EXPECT_EQ(result.compared, expected.compared);
+    EXPECT_EQ(result.different, expected.different);
+    EXPECT_DOUBLE_EQ(result.maxError, expected.maxError);
+    EXPECT_NEAR(result.rmse, expected.rmse, 1e-9);
+    EXPECT_EQ(result.relativeErrors, expected.relativeErrors);
+    ASSERT_EQ(cells.size(), expected.different);
+    for (const geo::DiffCell &cell : cells)
+    {
+      EXPECT_EQ(cell.row, 100);
+      EXPECT_EQ(cell.column, 7);
+    }
+  }
+
+  // Identical grids are decided from the sidecars
+  const string copyPath = (currentPath / "hashCopy.bil").string();
+  ASSERT_EQ(geo::SaveGrid(gridA, copyPath, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::BuildHashes(copyPath, blockRows), geoStatus::SUCCESS);
+  EXPECT_TRUE(geo::IdenticalGrids(pathA, copyPath));
+  geo::GridDiff result;
+  ASSERT_EQ(geo::DiffGrids(pathA, copyPath, CompareMode::ABSOLUTE, 0.1f, result), geoStatus::SUCCESS);
+  geo::GridDiff expected = loadedA.diff(loadedA, CompareMode::ABSOLUTE, 0.1f);
+  EXPECT_EQ(result.cells, expected.cells);
+  EXPECT_EQ(result.compared, expected.compared);
+  EXPECT_EQ(result.different, 0u);
+  EXPECT_EQ(result.relativeErrors, expected.relativeErrors);
+
+  // Grids replaced keeping an older modification time are not trusted
+  auto modified = fs::last_write_time(copyPath);
+  ASSERT_EQ(geo::SaveGrid(gridB, copyPath, GridFormat::ESRI_FLOAT), geoStatus::SUCCESS);
+  fs::last_write_time(copyPath, modified - std::chrono::hours(1));
+  EXPECT_EQ(geo::LoadHashes(copyPath, loaded), geoStatus::FAILURE);
+  EXPECT_FALSE(geo::IdenticalGrids(pathA, copyPath));
+  ASSERT_EQ(geo::DiffGrids(pathA, copyPath, CompareMode::ABSOLUTE, 0.1f, result), geoStatus::SUCCESS);
+  EXPECT_EQ(result.different, 1u);
+
+  // Headers are checked too
+  ASSERT_EQ(geo::BuildHashes(copyPath, blockRows), geoStatus::SUCCESS);
+  ASSERT_EQ(geo::LoadHashes(copyPath, loaded), geoStatus::SUCCESS);
+  fs::path header(copyPath);
+  header.replace_extension(".hdr");
+  fs::last_write_time(header, fs::last_write_time(header) + std::chrono::seconds(10));
+  EXPECT_EQ(geo::LoadHashes(copyPath, loaded), geoStatus::FAILURE);
+}
+
 Grid createSequentialGrid(geo::GridFormat format, int rows, int columns, double x0, double y0, double dx, double dy)
 {
 
@@ -464,23 +2621,18 @@ bool isSequentialGrid(const Grid &grid)
   // Get grid dimensions
   auto [rows, columns] = grid.dimensions();
 
-  // Calculate total of elements
-  int n = rows * columns;
-  int i = 0;
-  const float *start = grid.c_float();
-  const float *ptr = start;
-
-  while (i < n)
+  // Element at row i, column j must be equal to (i * columns) + j
+  for (int i = 0; i < rows; i++)
   {
-    // cout << i << " = " << *ptr << endl;
-    //  Element at position i must be equal to i
-    if (*ptr != (float)i)
+    for (int j = 0; j < columns; j++)
     {
-      cout << i << " != " << *ptr << endl;
-      return false;
+      float expected = (float)((i * columns) + j);
+      if (grid(i, j) != expected)
+      {
+        cout << expected << " != " << grid(i, j) << endl;
+        return false;
+      }
     }
-    i++;
-    ptr++;
   }
 
   return true;